@@ -1,4 +1,6 @@
 #include <UnityAsset/ShaderBlob.h>
+#include <UnityAsset/Streams/InMemoryStreamBackingBuffer.h>
+#include <UnityAsset/Streams/PooledStreamBackingBuffer.h>
 
 #include <list>
 
@@ -24,11 +26,12 @@ namespace UnityAsset {
         std::vector<Stream> uncompressedSegments;
         uncompressedSegments.reserve(numberOfSegments);
 
+        /*
+         * The entries are views of the segments, so the segments live as
+         * long as the blob, and are allocated at their exact size.
+         */
         for(size_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
-            UnityAsset::Stream segmentStream;
-
-            segmentStream.setPosition(decompressedLengths[segmentIndex]);
-            segmentStream.setPosition(0);
+            UnityAsset::Stream segmentStream(std::make_shared<InMemoryStreamBackingBuffer>(decompressedLengths[segmentIndex]));
 
             auto result = LZ4_decompress_safe(
                 reinterpret_cast<const char *>(compressedBlob.data()) + offsets[segmentIndex],
@@ -82,7 +85,7 @@ namespace UnityAsset {
 
         std::list<Stream> uncompressedSegments;
 
-        auto &headerStream = uncompressedSegments.emplace_back();
+        auto &headerStream = uncompressedSegments.emplace_back(std::make_shared<PooledStreamBackingBuffer>());
 
         size_t offset = 4 + 12 * entries.size();
         size_t segmentIndex = 0;
@@ -97,7 +100,7 @@ namespace UnityAsset {
             if(((offset + 15) & ~15) + entry.length() > 16 * 1024 * 1024) {
                 segmentIndex++;
                 offset = 0;
-                uncompressedSegments.emplace_back().setByteOrder(Stream::ByteOrder::LeastSignificantFirst);
+                uncompressedSegments.emplace_back(std::make_shared<PooledStreamBackingBuffer>()).setByteOrder(Stream::ByteOrder::LeastSignificantFirst);
             }
 
 
@@ -0,0 +1,68 @@
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleBlockCache.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleBlockStreamBackingBuffer.h>
+
+#include <limits>
+
+namespace UnityAsset {
+
+    AssetBundleBlockCache::AssetBundleBlockCache() : m_capacity(std::numeric_limits<size_t>::max()), m_residentBytes(0),
+        m_hits(0), m_misses(0), m_evictions(0) {
+
+    }
+
+    AssetBundleBlockCache::~AssetBundleBlockCache() = default;
+
+    AssetBundleBlockCache &AssetBundleBlockCache::instance() {
+        /*
+         * Intentionally never destroyed: the bundles may outlive the static
+         * destructors.
+         */
+        static auto cache = new AssetBundleBlockCache;
+
+        return *cache;
+    }
+
+    void AssetBundleBlockCache::setCapacity(size_t capacity) {
+        std::unique_lock<std::mutex> locker(m_mutex);
+
+        m_capacity = capacity;
+
+        evictExcessBlocks();
+    }
+
+    size_t AssetBundleBlockCache::capacity() const {
+        std::unique_lock<std::mutex> locker(m_mutex);
+
+        return m_capacity;
+    }
+
+    auto AssetBundleBlockCache::statistics() const -> Statistics {
+        std::unique_lock<std::mutex> locker(m_mutex);
+
+        return Statistics{
+            .hits = m_hits,
+            .misses = m_misses,
+            .evictions = m_evictions,
+            .residentBytes = m_residentBytes,
+            .capacity = m_capacity
+        };
+    }
+
+    void AssetBundleBlockCache::resetStatistics() {
+        std::unique_lock<std::mutex> locker(m_mutex);
+
+        m_hits = 0;
+        m_misses = 0;
+        m_evictions = 0;
+    }
+
+    void AssetBundleBlockCache::evictExcessBlocks() {
+        while(m_residentBytes > m_capacity && !m_unreferencedBlocks.empty()) {
+            auto victim = m_unreferencedBlocks.back();
+            m_unreferencedBlocks.pop_back();
+
+            m_residentBytes -= victim.buffer->discardBlock(victim.blockIndex);
+            m_evictions++;
+        }
+    }
+}
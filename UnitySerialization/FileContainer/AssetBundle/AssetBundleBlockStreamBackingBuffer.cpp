@@ -0,0 +1,433 @@
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleBlockStreamBackingBuffer.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleBlock.h>
+
+#if defined(_WIN32)
+#include <UnityAsset/WindowsError.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <exception>
+#include <execution>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace UnityAsset {
+
+    const size_t AssetBundleBlockStreamBackingBuffer::m_pageSize = queryPageSize();
+
+    AssetBundleBlockStreamBackingBuffer::AssetBundleBlockStreamBackingBuffer(Stream &&compressedData, const std::vector<AssetBundleBlock> &blocks,
+                                                                             unsigned int decompressionThreads, bool calculateCRC) :
+        m_compressedData(std::move(compressedData)), m_decompressionThreads(decompressionThreads), m_calculateCRC(calculateCRC),
+        m_data(nullptr), m_size(0) {
+
+        if(m_decompressionThreads == 0)
+            m_decompressionThreads = std::max(1U, std::thread::hardware_concurrency());
+
+        m_blocks.reserve(blocks.size());
+
+        size_t compressedOffset = 0;
+
+        for(const auto &block: blocks) {
+            m_blocks.emplace_back(Block{
+                .compressedOffset = compressedOffset,
+                .uncompressedOffset = m_size,
+                .compressedSize = block.compressedSize,
+                .uncompressedSize = block.uncompressedSize,
+                .compression = static_cast<UnityCompressionType>(block.flags & UINT16_C(0x3F)),
+                .state = BlockState::Absent,
+                .unreferenced = false,
+                .crc = 0,
+                .references = 0,
+                .unreferencedPosition = {}
+            });
+
+            compressedOffset += block.compressedSize;
+            m_size += block.uncompressedSize;
+        }
+
+        if(compressedOffset != m_compressedData.length())
+            throw std::logic_error("AssetBundleBlockStreamBackingBuffer: the block sizes are inconsistent with the compressed data length");
+
+        if(m_size != 0) {
+#if defined(_WIN32)
+            /*
+             * Only the address space is reserved here. The pages of each
+             * block are committed right before it's decompressed, so the
+             * untouched blocks don't count against the commit limit.
+             */
+            m_data = static_cast<unsigned char *>(VirtualAlloc(nullptr, m_size, MEM_RESERVE, PAGE_NOACCESS));
+            if(m_data == nullptr)
+                WindowsError::throwLastError();
+#else
+            /*
+             * Anonymous pages don't take up any memory until they're
+             * written to, so the untouched blocks cost nothing.
+             */
+            auto mapping = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if(mapping == MAP_FAILED)
+                throw std::system_error(errno, std::generic_category());
+
+            m_data = static_cast<unsigned char *>(mapping);
+#endif
+        }
+    }
+
+    AssetBundleBlockStreamBackingBuffer::~AssetBundleBlockStreamBackingBuffer() {
+        {
+            auto &cache = AssetBundleBlockCache::instance();
+
+            std::unique_lock<std::mutex> locker(cache.m_mutex);
+
+            for(auto &block: m_blocks) {
+                if(block.unreferenced) {
+                    cache.m_unreferencedBlocks.erase(block.unreferencedPosition);
+                }
+
+                if(block.state == BlockState::Resident) {
+                    cache.m_residentBytes -= block.uncompressedSize;
+                }
+            }
+        }
+
+        if(m_data != nullptr) {
+#if defined(_WIN32)
+            VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+            munmap(m_data, m_size);
+#endif
+        }
+    }
+
+    size_t AssetBundleBlockStreamBackingBuffer::size() const {
+        return m_size;
+    }
+
+    void AssetBundleBlockStreamBackingBuffer::resize(size_t size) {
+        (void)size;
+
+        throw std::logic_error("AssetBundleBlockStreamBackingBuffer::resize: not resizable");
+    }
+
+    const unsigned char *AssetBundleBlockStreamBackingBuffer::data() const {
+        return m_data;
+    }
+
+    uint32_t AssetBundleBlockStreamBackingBuffer::crc() const {
+        if(!m_calculateCRC)
+            throw std::logic_error("AssetBundleBlockStreamBackingBuffer::crc: the CRC is not being calculated");
+
+        uint32_t crc = 0;
+
+        for(const auto &block: m_blocks) {
+            crc = static_cast<uint32_t>(crc32_combine(crc, block.crc, block.uncompressedSize));
+        }
+
+        return crc;
+    }
+
+    size_t AssetBundleBlockStreamBackingBuffer::blockCount() const {
+        return m_blocks.size();
+    }
+
+    auto AssetBundleBlockStreamBackingBuffer::compressedBlock(size_t blockIndex) const -> CompressedBlock {
+        const auto &block = m_blocks.at(blockIndex);
+
+        return CompressedBlock{
+            .uncompressedOffset = block.uncompressedOffset,
+            .uncompressedSize = block.uncompressedSize,
+            .compression = block.compression,
+            .compressedData = m_compressedData.data() + block.compressedOffset,
+            .compressedSize = block.compressedSize
+        };
+    }
+
+    auto AssetBundleBlockStreamBackingBuffer::blockContaining(size_t offset) -> std::vector<Block>::iterator {
+        return std::upper_bound(m_blocks.begin(), m_blocks.end(), offset, [](size_t offset, const Block &block) {
+            return offset < block.uncompressedOffset;
+        }) - 1;
+    }
+
+    void AssetBundleBlockStreamBackingBuffer::acquire(size_t offset, size_t size) {
+        if(size == 0)
+            return;
+
+        auto &cache = AssetBundleBlockCache::instance();
+
+        auto firstBlock = blockContaining(offset);
+        auto endOffset = offset + size;
+
+        std::vector<Block *> claimedBlocks;
+
+        std::unique_lock<std::mutex> locker(cache.m_mutex);
+
+        /*
+         * Referencing the blocks first makes sure that they can't be evicted
+         * while we're waiting for them.
+         */
+        for(auto block = firstBlock; block != m_blocks.end() && block->uncompressedOffset < endOffset; ++block) {
+            if(block->references++ == 0 && block->unreferenced) {
+                cache.m_unreferencedBlocks.erase(block->unreferencedPosition);
+                block->unreferenced = false;
+            }
+
+            if(block->state == BlockState::Absent) {
+                cache.m_misses++;
+            } else {
+                cache.m_hits++;
+            }
+        }
+
+        while(true) {
+            bool loadingElsewhere = false;
+
+            claimedBlocks.clear();
+
+            for(auto block = firstBlock; block != m_blocks.end() && block->uncompressedOffset < endOffset; ++block) {
+                if(block->state == BlockState::Absent) {
+                    block->state = BlockState::Loading;
+                    claimedBlocks.emplace_back(&*block);
+                } else if(block->state == BlockState::Loading) {
+                    loadingElsewhere = true;
+                }
+            }
+
+            if(!claimedBlocks.empty()) {
+                locker.unlock();
+
+                try {
+                    uncompressBlocks(claimedBlocks);
+                } catch(...) {
+                    locker.lock();
+
+                    for(auto block: claimedBlocks) {
+                        block->state = BlockState::Absent;
+                    }
+
+                    cache.m_blockStateChanged.notify_all();
+
+                    unreferenceBlocks(firstBlock, endOffset, cache);
+
+                    throw;
+                }
+
+                locker.lock();
+
+                for(auto block: claimedBlocks) {
+                    block->state = BlockState::Resident;
+                    cache.m_residentBytes += block->uncompressedSize;
+                }
+
+                cache.m_blockStateChanged.notify_all();
+
+                cache.evictExcessBlocks();
+
+            } else if(loadingElsewhere) {
+                /*
+                 * Some of the blocks are being decompressed by another
+                 * thread. If that fails, they go back to Absent and will be
+                 * picked up on the next iteration.
+                 */
+                cache.m_blockStateChanged.wait(locker);
+
+            } else {
+                break;
+            }
+        }
+    }
+
+    void AssetBundleBlockStreamBackingBuffer::release(size_t offset, size_t size) noexcept {
+        if(size == 0)
+            return;
+
+        auto &cache = AssetBundleBlockCache::instance();
+
+        std::unique_lock<std::mutex> locker(cache.m_mutex);
+
+        unreferenceBlocks(blockContaining(offset), offset + size, cache);
+
+        cache.evictExcessBlocks();
+    }
+
+    void AssetBundleBlockStreamBackingBuffer::unreferenceBlocks(std::vector<Block>::iterator firstBlock, size_t endOffset,
+                                                                AssetBundleBlockCache &cache) {
+
+        for(auto block = firstBlock; block != m_blocks.end() && block->uncompressedOffset < endOffset; ++block) {
+            if(--block->references == 0 && block->state == BlockState::Resident) {
+                cache.m_unreferencedBlocks.emplace_front(AssetBundleBlockCache::CachedBlock{
+                    .buffer = this,
+                    .blockIndex = static_cast<size_t>(block - m_blocks.begin())
+                });
+
+                block->unreferencedPosition = cache.m_unreferencedBlocks.begin();
+                block->unreferenced = true;
+            }
+        }
+    }
+
+    size_t AssetBundleBlockStreamBackingBuffer::discardBlock(size_t blockIndex) {
+        auto &block = m_blocks[blockIndex];
+
+        block.state = BlockState::Absent;
+        block.unreferenced = false;
+
+        /*
+         * Only the pages that are entirely within the block can be given
+         * back, the partial ones at the edges may be shared with the
+         * neighbouring blocks.
+         */
+        auto start = (block.uncompressedOffset + m_pageSize - 1) & ~(m_pageSize - 1);
+        auto end = (block.uncompressedOffset + block.uncompressedSize) & ~(m_pageSize - 1);
+
+        if(start < end) {
+#if defined(_WIN32)
+            VirtualFree(m_data + start, end - start, MEM_DECOMMIT);
+#else
+            madvise(m_data + start, end - start, MADV_DONTNEED);
+#endif
+        }
+
+        return block.uncompressedSize;
+    }
+
+    void AssetBundleBlockStreamBackingBuffer::prefetch(size_t offset, size_t size) {
+        if(size == 0 || m_blocks.empty())
+            return;
+
+        std::vector<Block *> blocks;
+
+        for(auto block = blockContaining(offset); block != m_blocks.end() && block->uncompressedOffset < offset + size; ++block) {
+            blocks.emplace_back(&*block);
+        }
+
+        prefetchCompressedData(blocks);
+    }
+
+    void AssetBundleBlockStreamBackingBuffer::prefetchCompressedData(const std::vector<Block *> &blocks) const {
+        /*
+         * The blocks are stored back to back, so the adjacent ones are
+         * merged into a single range.
+         */
+        size_t rangeStart = 0;
+        size_t rangeEnd = 0;
+
+        for(auto block: blocks) {
+            if(block->compressedOffset != rangeEnd) {
+                if(rangeStart != rangeEnd)
+                    m_compressedData.prefetch(rangeStart, rangeEnd - rangeStart);
+
+                rangeStart = block->compressedOffset;
+            }
+
+            rangeEnd = block->compressedOffset + block->compressedSize;
+        }
+
+        if(rangeStart != rangeEnd)
+            m_compressedData.prefetch(rangeStart, rangeEnd - rangeStart);
+    }
+
+    void AssetBundleBlockStreamBackingBuffer::uncompressBlocks(const std::vector<Block *> &blocks) const {
+        /*
+         * Start reading in the compressed data of all of the blocks, so that
+         * the later ones arrive while the earlier ones are decompressed.
+         */
+        prefetchCompressedData(blocks);
+
+        /*
+         * The blocks are split into at most m_decompressionThreads runs, and
+         * every run is a single task for the parallel algorithm, so no more
+         * than that many blocks are being decompressed at the same time.
+         */
+
+        struct BlockRun {
+            std::vector<Block *>::const_iterator firstBlock;
+            std::vector<Block *>::const_iterator endBlock;
+            std::exception_ptr error;
+        };
+
+        auto runCount = std::min<size_t>(m_decompressionThreads, blocks.size());
+
+        std::vector<BlockRun> runs;
+        runs.reserve(runCount);
+
+        for(size_t run = 0; run < runCount; run++) {
+            runs.emplace_back(BlockRun{
+                .firstBlock = blocks.begin() + run * blocks.size() / runCount,
+                .endBlock = blocks.begin() + (run + 1) * blocks.size() / runCount,
+                .error = nullptr
+            });
+        }
+
+        auto compressedData = m_compressedData.data();
+
+        auto uncompressRun = [this, compressedData](BlockRun &run) {
+            /*
+             * Exceptions may not escape from the parallel algorithm, so
+             * they're carried out and rethrown on the calling thread.
+             */
+            try {
+                for(auto it = run.firstBlock; it != run.endBlock; ++it) {
+                    auto &block = **it;
+
+#if defined(_WIN32)
+                    /*
+                     * Committing the pages that are already committed, such
+                     * as the ones shared with a neighbouring block, is a no-op.
+                     */
+                    if(block.uncompressedSize != 0 &&
+                       !VirtualAlloc(m_data + block.uncompressedOffset, block.uncompressedSize, MEM_COMMIT, PAGE_READWRITE))
+                        WindowsError::throwLastError();
+#endif
+
+                    unityUncompress(compressedData + block.compressedOffset, block.compressedSize, block.compression,
+                                    m_data + block.uncompressedOffset, block.uncompressedSize);
+
+                    /*
+                     * The block is still in the cache at this point, so
+                     * this is much cheaper than a separate pass.
+                     */
+                    if(m_calculateCRC)
+                        block.crc = static_cast<uint32_t>(crc32(UINT32_C(0), m_data + block.uncompressedOffset, block.uncompressedSize));
+                }
+            } catch(...) {
+                run.error = std::current_exception();
+            }
+        };
+
+        if(runs.size() == 1) {
+            uncompressRun(runs.front());
+        } else {
+            std::for_each(std::execution::par, runs.begin(), runs.end(), uncompressRun);
+        }
+
+        for(const auto &run: runs) {
+            if(run.error)
+                std::rethrow_exception(run.error);
+        }
+    }
+
+#if defined(_WIN32)
+    size_t AssetBundleBlockStreamBackingBuffer::queryPageSize() {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        return info.dwPageSize;
+    }
+#else
+    size_t AssetBundleBlockStreamBackingBuffer::queryPageSize() {
+        auto pageSize = sysconf(_SC_PAGESIZE);
+        if(pageSize < 0)
+            throw std::system_error(errno, std::generic_category());
+
+        if(pageSize & (pageSize - 1))
+            throw std::logic_error("the page size is not a power of two");
+
+        return static_cast<size_t>(pageSize);
+    }
+#endif
+}
@@ -31,6 +31,8 @@ namespace UnityAsset {
 
         files.resize(fileCount);
         input >> files;
+
+        m_input.emplace(std::move(input));
     }
 
 
@@ -1,7 +1,14 @@
 #include <UnityAsset/FileContainer/AssetBundle/AssetBundleEntry.h>
 
 namespace UnityAsset {
-    AssetBundleEntry::AssetBundleEntry(std::string &&filename, Stream &&data, uint32_t flags) : m_filename(std::move(filename)), m_data(std::move(data)), m_flags(flags) {
+    AssetBundleEntry::AssetBundleEntry(std::string &&filename, Stream &&data, uint32_t flags) : m_filename(std::move(filename)), m_data(std::move(data)),
+        m_deferredOffset(0), m_size(m_data->length()), m_flags(flags) {
+
+    }
+
+    AssetBundleEntry::AssetBundleEntry(std::string &&filename, const std::shared_ptr<StreamBackingBuffer> &backingBuffer, size_t offset, size_t size,
+                                       uint32_t flags) : m_filename(std::move(filename)), m_deferredBackingBuffer(backingBuffer),
+        m_deferredOffset(offset), m_size(size), m_flags(flags) {
 
     }
 
@@ -10,5 +17,19 @@ namespace UnityAsset {
     AssetBundleEntry::AssetBundleEntry(AssetBundleEntry &&other) noexcept = default;
 
     AssetBundleEntry &AssetBundleEntry::operator =(AssetBundleEntry &&other) noexcept = default;
+
+    Stream AssetBundleEntry::data() const {
+        if(m_data.has_value())
+            return *m_data;
+
+        return Stream(m_deferredBackingBuffer, m_deferredOffset, m_size);
+    }
+
+    void AssetBundleEntry::replace(Stream &&data) {
+        m_size = data.length();
+        m_data = std::move(data);
+        m_deferredBackingBuffer.reset();
+        m_deferredOffset = 0;
+    }
 }
 
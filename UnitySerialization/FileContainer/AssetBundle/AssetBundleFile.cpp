@@ -1,21 +1,33 @@
 #include "UnityAsset/UnityCompression.h"
 #include <UnityAsset/FileContainer/AssetBundle/AssetBundleFile.h>
 #include <UnityAsset/FileContainer/AssetBundle/AssetBundleDirectory.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleHeader.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleBlockStreamBackingBuffer.h>
 
 #include <UnityAsset/Streams/Stream.h>
 #include <UnityAsset/Streams/InMemoryStreamBackingBuffer.h>
+#include <UnityAsset/Streams/ScratchBuffer.h>
+#include <UnityAsset/Streams/FileInputOutput.h>
+
+#if defined(_WIN32)
+#include <UnityAsset/WindowsHandle.h>
+#else
+#include <UnityAsset/FileDescriptor.h>
+#endif
 
 #include <zlib.h>
 
+#include <cstring>
 #include <limits>
 
 #include <algorithm>
+#include <exception>
 #include <execution>
+#include <thread>
 
 namespace UnityAsset {
 
-    AssetBundleFile::AssetBundleFile() : directoryCompression(UnityCompressionType::LZ4HC), dataCompression(UnityCompressionType::None),
-        blockSize(128 * 1024) {
+    AssetBundleFile::AssetBundleFile() : directoryCompression(UnityCompressionType::LZ4HC), dataCompression(UnityCompressionType::None) {
 
     }
 
@@ -25,99 +37,71 @@ namespace UnityAsset {
 
     AssetBundleFile &AssetBundleFile::operator =(AssetBundleFile &&other) noexcept = default;
 
-    AssetBundleFile::AssetBundleFile(Stream &&stream) : AssetBundleFile() {
-        stream.setByteOrder(Stream::ByteOrder::MostSignificantFirst);
-
-        auto signature = stream.readNullTerminatedString();
-        if(signature != AssetBundleSignature)
-            throw std::runtime_error("AssetBundleFile: bad signature");
-
-        uint32_t version;
-        stream >> version;
+    AssetBundleFile::AssetBundleFile(Stream &&stream) : AssetBundleFile(std::move(stream), AssetBundleLoadOptions()) {
 
-        if(version != AssetBundleVersion)
-            throw std::runtime_error("AssetBundleFile: bad version");
-
-        unityVersion = stream.readNullTerminatedString();
-        unityRevision = stream.readNullTerminatedString();
-
-        uint64_t fileSize;
-        stream >> fileSize;
+    }
 
-        if(fileSize > stream.length())
-            throw std::runtime_error("AssetBundleFile: mismatched file size");
+    AssetBundleFile::AssetBundleFile(Stream &&stream, const AssetBundleLoadOptions &options) : AssetBundleFile() {
+        AssetBundleHeader header(stream);
 
-        uint32_t compressedDirectoryLength;
-        uint32_t uncompressedDirectoryLength;
-        DirectoryFlags directoryFlags;
-        stream
-            >> compressedDirectoryLength
-            >> uncompressedDirectoryLength
-            >> directoryFlags;
+        unityVersion = std::move(header.unityVersion);
+        unityRevision = std::move(header.unityRevision);
+        directoryCompression = header.directoryCompression;
+        dataCompression = header.dataCompression;
 
-        if(directoryCompressionOptions(directoryFlags) != BlocksAndDirectoryInfoCombined)
-            throw std::runtime_error("AssetBundleFile: unsupported directory options");
+        const auto &directory = header.directory;
+        auto totalCompressedSize = header.totalCompressedSize;
 
-        directoryCompression = directoryCompressionType(directoryFlags);
-        auto compressedDirectory = stream.createView(stream.position(), compressedDirectoryLength);
-        stream.setPosition(stream.position() + compressedDirectoryLength);
+        entries.reserve(directory.files.size());
 
-        auto uncompressedDirectory = unityUncompress(std::move(compressedDirectory), directoryCompression, uncompressedDirectoryLength);
+        if(dataCompression == UnityCompressionType::None) {
+            /*
+             * Nothing to decompress: the entries can refer to the input
+             * directly, which is free when it's a mapped file.
+             */
+            auto body = stream.createView(header.dataOffset, totalCompressedSize);
 
-        AssetBundleDirectory directory(std::move(uncompressedDirectory));
-        for(auto byte: directory.uncompressedDataHash)
-            if(byte != 0)
-                throw std::runtime_error("AssetBundleFile: uncompressedDataHash is non-zero");
+            if(options.calculateCRC && !options.lazyDecompression) {
+                assetBundleCRC.emplace(calculateCRC32(body.data(), body.length(), options.decompressionThreads));
+            }
 
-        size_t totalCompressedSize = 0;
-        size_t totalUncompressedSize = 0;
+            for(const auto &file: directory.files) {
+                entries.emplace_back(std::string(file.path), body.createView(file.fileOffset, file.fileSize), file.fileFlags);
+            }
 
-        for(const auto &block: directory.blocks) {
-            totalCompressedSize += block.compressedSize;
-            totalUncompressedSize += block.uncompressedSize;
+            return;
         }
 
-        if(stream.position() + totalCompressedSize != fileSize)
-            throw std::runtime_error("AssetBundleFile: total compressed length is inconsistent with the stream length");
+        auto uncompressedData = std::make_shared<AssetBundleBlockStreamBackingBuffer>(
+            stream.createView(header.dataOffset, totalCompressedSize), directory.blocks, options.decompressionThreads,
+            options.calculateCRC && !options.lazyDecompression);
 
-        auto compressedData = stream.data() + stream.position();
-        std::vector<unsigned char> uncompressedDataBuffer;
-        uncompressedDataBuffer.resize(totalUncompressedSize);
-        auto uncompressedData = uncompressedDataBuffer.data();
+        m_originalData = uncompressedData;
 
-        for(const auto &block: directory.blocks) {
-            if((block.flags & ~UINT16_C(0x3F)) != 0) {
-                throw std::runtime_error("AssetBundleFile: unsupported block flags");
+        if(options.lazyDecompression) {
+            for(const auto &file: directory.files) {
+                entries.emplace_back(std::string(file.path), uncompressedData, file.fileOffset, file.fileSize, file.fileFlags);
             }
+        } else {
+            Stream decompressedStream(uncompressedData);
 
-            auto type = static_cast<UnityCompressionType>(block.flags & UINT16_C(0x3F));
-
-            if(type != UnityCompressionType::None) {
-                dataCompression = type;
+            if(options.calculateCRC) {
+                assetBundleCRC.emplace(uncompressedData->crc());
             }
 
-            unityUncompress(compressedData, block.compressedSize, type, uncompressedData, block.uncompressedSize);
-            compressedData += block.compressedSize;
-            uncompressedData += block.uncompressedSize;
-        }
-        assetBundleCRC.emplace(crc32(UINT32_C(0), uncompressedDataBuffer.data(), uncompressedDataBuffer.size()));
-
-        Stream decompressedStream(std::make_shared<InMemoryStreamBackingBuffer>(std::move(uncompressedDataBuffer)));
-
-        entries.reserve(directory.files.size());
-
-        for(const auto &file: directory.files) {
-            auto view = decompressedStream.createView(file.fileOffset, file.fileSize);
+            for(const auto &file: directory.files) {
+                auto view = decompressedStream.createView(file.fileOffset, file.fileSize);
 
-            entries.emplace_back(std::string(file.path), std::move(view), file.fileFlags);
+                entries.emplace_back(std::string(file.path), std::move(view), file.fileFlags);
+            }
         }
     }
 
     void AssetBundleFile::serialize(Stream &stream) const {
         stream.setByteOrder(Stream::ByteOrder::MostSignificantFirst);
 
-        stream.writeNullTerminatedString(AssetBundleSignature);
-        stream << AssetBundleVersion;
+        stream.writeNullTerminatedString(AssetBundleHeader::Signature);
+        stream << AssetBundleHeader::Version;
 
         stream.writeNullTerminatedString(unityVersion);
         stream.writeNullTerminatedString(unityRevision);
@@ -137,35 +121,52 @@ namespace UnityAsset {
 
         size_t totalUncompressedSize = 0;
         for(const auto &entry: entries) {
-            totalUncompressedSize += (entry.data().length() + 15) & ~15;
+            totalUncompressedSize += (entry.size() + 15) & ~15;
         }
 
-        std::vector<unsigned char> uncompressedDataBuffer(totalUncompressedSize);
+        /*
+         * There's room for the CRC adjustment past the end of the data.
+         */
+        ScratchBuffer uncompressedDataBuffer(totalUncompressedSize + sizeof(uint32_t));
+        size_t uncompressedDataLength = totalUncompressedSize;
+        std::vector<CompressionRun> runs;
         size_t position = 0;
         for(const auto &entry: entries) {
+            auto level = entry.compressionLevel().value_or(compressionOptions.level);
+            if(runs.empty() || runs.back().level != level) {
+                runs.emplace_back(CompressionRun{ .offset = position, .level = level });
+            }
+
             auto &file = directory.files.emplace_back();
             file.fileOffset = position;
-            file.fileSize = entry.data().length();
+            file.fileSize = entry.size();
             file.path = entry.filename();
             file.fileFlags = entry.flags();
 
-            memcpy(uncompressedDataBuffer.data() + position, entry.data().data(), entry.data().length());
+            auto data = entry.data();
+            memcpy(uncompressedDataBuffer.data() + position, data.data(), data.length());
+
+            auto paddedSize = (file.fileSize + 15) & ~15;
+            memset(uncompressedDataBuffer.data() + position + file.fileSize, 0, paddedSize - file.fileSize);
 
-            position += (file.fileSize + 15) & ~15;
+            position += paddedSize;
+        }
+
+        if(runs.empty()) {
+            runs.emplace_back(CompressionRun{ .offset = 0, .level = compressionOptions.level });
         }
 
         if(assetBundleCRC.has_value()) {
-            auto contentCRC = static_cast<uint32_t>(crc32(UINT32_C(0), uncompressedDataBuffer.data(), uncompressedDataBuffer.size()));
+            auto contentCRC = static_cast<uint32_t>(crc32(UINT32_C(0), uncompressedDataBuffer.data(), uncompressedDataLength));
 
             if(contentCRC != *assetBundleCRC) {
                 auto adjustment = calculateCRC32Adjustment(contentCRC, *assetBundleCRC);
 
-                uncompressedDataBuffer.insert(uncompressedDataBuffer.end(),
-                                              reinterpret_cast<const unsigned char *>(&adjustment),
-                                              reinterpret_cast<const unsigned char *>(&adjustment) + sizeof(adjustment));
+                memcpy(uncompressedDataBuffer.data() + uncompressedDataLength, &adjustment, sizeof(adjustment));
+                uncompressedDataLength += sizeof(adjustment);
 
                 contentCRC = static_cast<uint32_t>(crc32(contentCRC,
-                                                         uncompressedDataBuffer.data() + uncompressedDataBuffer.size() - sizeof(adjustment),
+                                                         uncompressedDataBuffer.data() + uncompressedDataLength - sizeof(adjustment),
                                                          sizeof(adjustment)));
 
                 if(contentCRC != *assetBundleCRC) {
@@ -174,108 +175,79 @@ namespace UnityAsset {
             }
         }
 
-        std::vector<unsigned char> compressedBody;
+        ScratchBuffer compressedBody;
+        size_t compressedBodyLength;
 
-        if(dataCompression == UnityCompressionType::LZ4 || dataCompression == UnityCompressionType::LZ4HC) {
+        if(dataCompression != UnityCompressionType::None) {
             /*
-             * LZ4-compressed data needs to be chunked.
+             * LZ4-compressed data needs to be chunked. LZMA-compressed data
+             * is only chunked if requested, but the ranges compressed with
+             * different levels always go into separate blocks.
              */
 
-            compressedBody.resize(uncompressedDataBuffer.size());
-
-            auto dstPtr = compressedBody.data();
-            auto srcPtr = uncompressedDataBuffer.data();
-            auto srcEnd = uncompressedDataBuffer.data() + uncompressedDataBuffer.size();
-
-            struct DataChunk {
-                const unsigned char *uncompressedDataStart;
-                size_t uncompressedDataSize;
-
-                bool wasCompressed;
+            size_t chunkSize;
+            if(dataCompression == UnityCompressionType::LZMA && compressionOptions.lzmaBlockSize == 0) {
+                chunkSize = std::numeric_limits<size_t>::max();
+            } else {
+                chunkSize = dataBlockSize();
+            }
 
-                unsigned char *compressedDataStart;
-                size_t compressedDataSize;
-            };
+            compressedBody = ScratchBuffer(uncompressedDataLength);
 
             std::vector<DataChunk> chunks;
 
-            while(srcPtr < srcEnd) {
-                auto block = std::min<size_t>(srcEnd - srcPtr, blockSize);
-
-                chunks.emplace_back(DataChunk{
-                    .uncompressedDataStart = srcPtr,
-                    .uncompressedDataSize = block,
-                    .wasCompressed = false,
-                    .compressedDataStart = dstPtr,
-                    .compressedDataSize = block
-                });
-
-                srcPtr += block;
-                dstPtr += block;
+            size_t originalLayoutLength = 0;
+            if(compressionOptions.reuseUnchangedBlocks && m_originalData) {
+                originalLayoutLength = splitIntoOriginalBlocks(uncompressedDataBuffer.data(), uncompressedDataLength, compressedBody.data(),
+                                                               runs, chunks);
             }
 
-            std::for_each(std::execution::par_unseq, chunks.begin(), chunks.end(), [this](DataChunk &chunk) {
-                chunk.wasCompressed = unityCompress(chunk.uncompressedDataStart, chunk.uncompressedDataSize, dataCompression,
-                                                    chunk.compressedDataStart, chunk.compressedDataSize);
-            });
+            splitIntoChunks(uncompressedDataBuffer.data(), originalLayoutLength, uncompressedDataLength, compressedBody.data(),
+                            runs, chunkSize, chunks);
 
-            dstPtr = compressedBody.data();
+            compressChunks(chunks);
 
-            for(auto &chunk: chunks) {
-                if(chunk.compressedDataStart != dstPtr) {
-                    memmove(dstPtr, chunk.compressedDataStart, chunk.compressedDataSize);
-                }
+            auto dstPtr = compressedBody.data();
 
+            for(auto &chunk: chunks) {
                 auto &blockdef = directory.blocks.emplace_back();
-                blockdef.compressedSize = chunk.compressedDataSize;
                 blockdef.uncompressedSize = chunk.uncompressedDataSize;
 
                 if(chunk.wasCompressed) {
+                    if(chunk.compressedDataStart != dstPtr) {
+                        memmove(dstPtr, chunk.compressedDataStart, chunk.compressedDataSize);
+                    }
+
+                    blockdef.compressedSize = chunk.compressedDataSize;
                     blockdef.flags = static_cast<uint16_t>(dataCompression);
                 } else {
+                    /*
+                     * The chunks that weren't compressed are written from
+                     * the uncompressed data, which is in a separate buffer.
+                     */
+                    memcpy(dstPtr, chunk.uncompressedDataStart, chunk.uncompressedDataSize);
+
+                    blockdef.compressedSize = chunk.uncompressedDataSize;
                     blockdef.flags = static_cast<uint16_t>(UnityCompressionType::None);
                 }
 
-                dstPtr += chunk.compressedDataSize;
+                dstPtr += blockdef.compressedSize;
             }
 
 
-            compressedBody.resize(dstPtr - compressedBody.data());
+            compressedBodyLength = dstPtr - compressedBody.data();
         } else {
 
-            if(uncompressedDataBuffer.size() > std::numeric_limits<int32_t>::max())
+            if(uncompressedDataLength > std::numeric_limits<int32_t>::max())
                 throw std::runtime_error("the uncompressed data is too long");
 
-            size_t uncompressedLength = uncompressedDataBuffer.size();
-
-            UnityCompressionType actualCompressionType;
-
-            if(dataCompression == UnityCompressionType::None) {
-                compressedBody = std::move(uncompressedDataBuffer);
-                actualCompressionType = UnityCompressionType::None;
-            } else {
-                compressedBody.resize(uncompressedLength);
-
-                size_t outputLength;
-                if(unityCompress(uncompressedDataBuffer.data(), uncompressedDataBuffer.size(), dataCompression, compressedBody.data(), outputLength)) {
-
-                    compressedBody.resize(outputLength);
-
-                    actualCompressionType = dataCompression;
-                } else {
-                    compressedBody = std::move(uncompressedDataBuffer);
-                    actualCompressionType = UnityCompressionType::None;
-                }
-            }
-
-            if(compressedBody.size() > std::numeric_limits<int32_t>::max())
-                throw std::runtime_error("the compressed data is too long");
-
+            compressedBody = std::move(uncompressedDataBuffer);
+            compressedBodyLength = uncompressedDataLength;
 
             auto &blockdef = directory.blocks.emplace_back();
-            blockdef.compressedSize = compressedBody.size();
-            blockdef.uncompressedSize = uncompressedLength;
-            blockdef.flags = static_cast<uint16_t>(actualCompressionType);
+            blockdef.compressedSize = compressedBodyLength;
+            blockdef.uncompressedSize = uncompressedDataLength;
+            blockdef.flags = static_cast<uint16_t>(UnityCompressionType::None);
         }
 
 
@@ -288,9 +260,9 @@ namespace UnityAsset {
         size_t compressedDirectoryLength;
         uint32_t directoryFlags;
         if(unityCompress(uncompressedDirectory.data(), uncompressedDirectory.length(), directoryCompression, compressedDirectory.data(), compressedDirectoryLength)) {
-            directoryFlags = static_cast<uint32_t>(directoryCompression) | BlocksAndDirectoryInfoCombined;
+            directoryFlags = static_cast<uint32_t>(directoryCompression) | AssetBundleHeader::BlocksAndDirectoryInfoCombined;
         } else {
-            directoryFlags = static_cast<uint32_t>(UnityCompressionType::None) | BlocksAndDirectoryInfoCombined;
+            directoryFlags = static_cast<uint32_t>(UnityCompressionType::None) | AssetBundleHeader::BlocksAndDirectoryInfoCombined;
         }
 
         stream
@@ -299,8 +271,9 @@ namespace UnityAsset {
             << static_cast<uint32_t>(directoryFlags);
 
         compressedDirectory.resize(compressedDirectoryLength);
+        stream.reserve(stream.position() + compressedDirectory.size() + compressedBodyLength);
         stream << compressedDirectory;
-        stream << compressedBody;
+        stream.writeData(compressedBody.data(), compressedBodyLength);
 
         /*
          * Rewrite the file size with the correct value.
@@ -313,6 +286,366 @@ namespace UnityAsset {
 
     }
 
+#if defined(_WIN32)
+    void AssetBundleFile::serialize(const WindowsHandle &output) const {
+#else
+    void AssetBundleFile::serialize(const FileDescriptor &output) const {
+#endif
+        Stream header;
+        header.setByteOrder(Stream::ByteOrder::MostSignificantFirst);
+
+        header.writeNullTerminatedString(AssetBundleHeader::Signature);
+        header << AssetBundleHeader::Version;
+
+        header.writeNullTerminatedString(unityVersion);
+        header.writeNullTerminatedString(unityRevision);
+
+        /*
+         * Placeholders for the file size, the directory lengths and the
+         * flags - will be rewritten once everything else is written out.
+         */
+        auto fileSizeOffset = header.position();
+        header << static_cast<uint64_t>(0) << static_cast<uint32_t>(0) << static_cast<uint32_t>(0) << static_cast<uint32_t>(0);
+
+        writeFile(output, header.data(), 0, header.length());
+
+        AssetBundleDirectory directory;
+        directory.files.reserve(entries.size());
+
+        auto threads = std::max(1U, std::thread::hardware_concurrency());
+        auto chunkSize = dataBlockSize();
+        auto windowCapacity = 4 * threads * chunkSize;
+
+        /*
+         * There's room for the CRC adjustment past the end of the window.
+         */
+        ScratchBuffer window(windowCapacity + sizeof(uint32_t));
+        ScratchBuffer compressedWindow(windowCapacity + sizeof(uint32_t));
+        size_t windowLength = 0;
+        std::vector<CompressionRun> windowRuns;
+
+        uint64_t outputPosition = header.length();
+        uint32_t contentCRC = 0;
+
+        auto flushWindow = [&](bool last) {
+            if(assetBundleCRC.has_value()) {
+                contentCRC = static_cast<uint32_t>(crc32_combine(contentCRC, calculateCRC32(window.data(), windowLength, threads),
+                                                                 static_cast<z_off_t>(windowLength)));
+
+                if(last && contentCRC != *assetBundleCRC) {
+                    auto adjustment = calculateCRC32Adjustment(contentCRC, *assetBundleCRC);
+
+                    memcpy(window.data() + windowLength, &adjustment, sizeof(adjustment));
+
+                    contentCRC = static_cast<uint32_t>(crc32(contentCRC, window.data() + windowLength, sizeof(adjustment)));
+                    windowLength += sizeof(adjustment);
+
+                    if(contentCRC != *assetBundleCRC) {
+                        throw std::logic_error("the CRC-32 didn't come to the needed value after adjustment");
+                    }
+                }
+            }
+
+            std::vector<DataChunk> chunks;
+            splitIntoChunks(window.data(), 0, windowLength, compressedWindow.data(), windowRuns, chunkSize, chunks);
+
+            if(dataCompression != UnityCompressionType::None) {
+                compressChunks(chunks);
+            }
+
+            /*
+             * The blocks of the window are written out with a single gather
+             * write, from wherever each of them ended up.
+             */
+            std::vector<FileSegment> segments;
+            segments.reserve(chunks.size());
+
+            auto windowPosition = outputPosition;
+
+            for(const auto &chunk: chunks) {
+                auto &blockdef = directory.blocks.emplace_back();
+                blockdef.uncompressedSize = chunk.uncompressedDataSize;
+
+                if(chunk.wasCompressed) {
+                    segments.emplace_back(FileSegment{ .data = chunk.compressedDataStart, .size = chunk.compressedDataSize });
+
+                    blockdef.compressedSize = chunk.compressedDataSize;
+                    blockdef.flags = static_cast<uint16_t>(dataCompression);
+                } else {
+                    segments.emplace_back(FileSegment{ .data = chunk.uncompressedDataStart, .size = chunk.uncompressedDataSize });
+
+                    blockdef.compressedSize = chunk.uncompressedDataSize;
+                    blockdef.flags = static_cast<uint16_t>(UnityCompressionType::None);
+                }
+
+                outputPosition += blockdef.compressedSize;
+            }
+
+            writeFile(output, segments, windowPosition);
+
+            /*
+             * The entry being copied continues into the next window.
+             */
+            windowLength = 0;
+            windowRuns.erase(windowRuns.begin(), windowRuns.end() - 1);
+            windowRuns.back().offset = 0;
+        };
+
+        size_t position = 0;
+        for(const auto &entry: entries) {
+            auto data = entry.data();
+
+            auto level = entry.compressionLevel().value_or(compressionOptions.level);
+            if(windowRuns.empty() || windowRuns.back().level != level) {
+                windowRuns.emplace_back(CompressionRun{ .offset = windowLength, .level = level });
+            }
+
+            auto &file = directory.files.emplace_back();
+            file.fileOffset = position;
+            file.fileSize = data.length();
+            file.path = entry.filename();
+            file.fileFlags = entry.flags();
+
+            size_t paddedSize = (file.fileSize + 15) & ~15;
+
+            for(size_t copied = 0; copied < paddedSize; ) {
+                if(windowLength == windowCapacity)
+                    flushWindow(false);
+
+                auto piece = std::min<size_t>(paddedSize - copied, windowCapacity - windowLength);
+                auto fromData = std::min<size_t>(piece, data.length() - std::min<size_t>(copied, data.length()));
+
+                if(fromData != 0)
+                    memcpy(window.data() + windowLength, data.data() + copied, fromData);
+
+                memset(window.data() + windowLength + fromData, 0, piece - fromData);
+
+                windowLength += piece;
+                copied += piece;
+            }
+
+            position += paddedSize;
+        }
+
+        if(windowRuns.empty()) {
+            windowRuns.emplace_back(CompressionRun{ .offset = 0, .level = compressionOptions.level });
+        }
+
+        flushWindow(true);
+
+        Stream uncompressedDirectory;
+        directory.serialize(uncompressedDirectory);
+
+        uint32_t uncompressedDirectoryLength = static_cast<uint32_t>(uncompressedDirectory.length());
+
+        std::vector<unsigned char> compressedDirectory(uncompressedDirectory.length());
+        size_t compressedDirectoryLength;
+        uint32_t directoryFlags;
+        if(unityCompress(uncompressedDirectory.data(), uncompressedDirectory.length(), directoryCompression, compressedDirectory.data(), compressedDirectoryLength)) {
+            directoryFlags = static_cast<uint32_t>(directoryCompression);
+        } else {
+            directoryFlags = static_cast<uint32_t>(UnityCompressionType::None);
+        }
+
+        directoryFlags |= AssetBundleHeader::BlocksAndDirectoryInfoCombined | AssetBundleHeader::BlocksInfoAtTheEnd;
+
+        writeFile(output, compressedDirectory.data(), outputPosition, compressedDirectoryLength);
+
+        uint64_t fileSize = outputPosition + compressedDirectoryLength;
+
+        header.setPosition(fileSizeOffset);
+        header
+            << fileSize
+            << static_cast<uint32_t>(compressedDirectoryLength)
+            << static_cast<uint32_t>(uncompressedDirectoryLength)
+            << static_cast<uint32_t>(directoryFlags);
+
+        writeFile(output, header.data(), 0, header.length());
+
+        /*
+         * The file may have held something longer before.
+         */
+        truncateFile(output, fileSize);
+    }
+
+    size_t AssetBundleFile::dataBlockSize() const {
+        if(dataCompression == UnityCompressionType::LZMA && compressionOptions.lzmaBlockSize != 0)
+            return compressionOptions.lzmaBlockSize;
+
+        return compressionOptions.blockSize;
+    }
+
+    void AssetBundleFile::splitIntoChunks(const unsigned char *data, size_t start, size_t length, unsigned char *compressedData,
+                                          const std::vector<CompressionRun> &runs, size_t chunkSize, std::vector<DataChunk> &chunks) {
+
+        for(auto run = runs.begin(); run != runs.end(); ++run) {
+            size_t runEnd;
+            if(run + 1 == runs.end()) {
+                runEnd = length;
+            } else {
+                runEnd = (run + 1)->offset;
+            }
+
+            for(size_t offset = std::max(run->offset, start); offset < runEnd; ) {
+                auto block = std::min<size_t>(runEnd - offset, chunkSize);
+
+                if(block > std::numeric_limits<int32_t>::max())
+                    throw std::runtime_error("the uncompressed data is too long");
+
+                chunks.emplace_back(DataChunk{
+                    .uncompressedDataStart = data + offset,
+                    .uncompressedDataSize = block,
+                    .compressionLevel = run->level,
+                    .wasCompressed = false,
+                    .compressedDataStart = compressedData + offset,
+                    .compressedDataSize = block,
+                    .originalBlock = NoOriginalBlock
+                });
+
+                offset += block;
+            }
+        }
+    }
+
+    /*
+     * Splits the start of the data into chunks that match the blocks of the
+     * file the bundle was loaded from, and returns the length covered.
+     */
+    size_t AssetBundleFile::splitIntoOriginalBlocks(const unsigned char *data, size_t length, unsigned char *compressedData,
+                                                    const std::vector<CompressionRun> &runs, std::vector<DataChunk> &chunks) const {
+        size_t offset = 0;
+        auto blockCount = m_originalData->blockCount();
+
+        for(size_t blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+            auto original = m_originalData->compressedBlock(blockIndex);
+
+            if(original.uncompressedSize > length - offset)
+                break;
+
+            auto run = std::upper_bound(runs.begin(), runs.end(), offset, [](size_t offset, const CompressionRun &run) {
+                return offset < run.offset;
+            }) - 1;
+
+            chunks.emplace_back(DataChunk{
+                .uncompressedDataStart = data + offset,
+                .uncompressedDataSize = original.uncompressedSize,
+                .compressionLevel = run->level,
+                .wasCompressed = false,
+                .compressedDataStart = compressedData + offset,
+                .compressedDataSize = original.uncompressedSize,
+                .originalBlock = blockIndex
+            });
+
+            offset += original.uncompressedSize;
+        }
+
+        return offset;
+    }
+
+    void AssetBundleFile::compressChunks(std::vector<DataChunk> &chunks) const {
+        for(const auto &chunk: chunks) {
+            validateCompressionLevel(dataCompression, chunk.compressionLevel);
+        }
+
+        /*
+         * Exceptions may not escape from the parallel algorithm, so they're
+         * carried out and rethrown on the calling thread.
+         */
+        std::vector<std::exception_ptr> errors(chunks.size());
+
+        /*
+         * Not par_unseq: the LZMA encoder allocates memory.
+         */
+        std::for_each(std::execution::par, chunks.begin(), chunks.end(), [this, &chunks, &errors](DataChunk &chunk) {
+            try {
+                /*
+                 * Acquiring the original blocks may decompress them, and
+                 * throw, in the lazy mode.
+                 */
+                if(chunk.originalBlock != NoOriginalBlock && reuseOriginalBlock(chunk))
+                    return;
+
+                chunk.wasCompressed = unityCompress(chunk.uncompressedDataStart, chunk.uncompressedDataSize, dataCompression,
+                                                    chunk.compressedDataStart, chunk.compressedDataSize, chunk.compressionLevel);
+            } catch(...) {
+                errors[&chunk - chunks.data()] = std::current_exception();
+            }
+        });
+
+        for(const auto &error: errors) {
+            if(error)
+                std::rethrow_exception(error);
+        }
+    }
+
+    bool AssetBundleFile::reuseOriginalBlock(DataChunk &chunk) const {
+        auto original = m_originalData->compressedBlock(chunk.originalBlock);
+
+        if(original.compression != dataCompression && original.compression != UnityCompressionType::None)
+            return false;
+
+        if(original.compressedSize > chunk.uncompressedDataSize)
+            return false;
+
+        Stream originalData(m_originalData, original.uncompressedOffset, original.uncompressedSize);
+
+        if(memcmp(originalData.data(), chunk.uncompressedDataStart, chunk.uncompressedDataSize) != 0)
+            return false;
+
+        memcpy(chunk.compressedDataStart, original.compressedData, original.compressedSize);
+        chunk.compressedDataSize = original.compressedSize;
+        chunk.wasCompressed = original.compression != UnityCompressionType::None;
+
+        return true;
+    }
+
+    /*
+     * Calculates the CRC-32 of the data in pieces on up to 'threads' threads,
+     * and then combines the results.
+     */
+    uint32_t AssetBundleFile::calculateCRC32(const unsigned char *data, size_t size, unsigned int threads) {
+        if(threads == 0)
+            threads = std::max(1U, std::thread::hardware_concurrency());
+
+        /*
+         * The pieces are bounded so that their lengths fit into the zlib
+         * length types, which may be 32-bit.
+         */
+        static constexpr size_t MinimumPieceSize = 1024 * 1024;
+        static constexpr size_t MaximumPieceSize = 1024 * 1024 * 1024;
+
+        auto pieceSize = std::clamp<size_t>((size + threads - 1) / threads, MinimumPieceSize, MaximumPieceSize);
+
+        struct Piece {
+            const unsigned char *data;
+            size_t size;
+            uint32_t crc;
+        };
+
+        std::vector<Piece> pieces;
+        pieces.reserve((size + pieceSize - 1) / pieceSize);
+
+        for(size_t offset = 0; offset < size; offset += pieceSize) {
+            pieces.emplace_back(Piece{
+                .data = data + offset,
+                .size = std::min(pieceSize, size - offset),
+                .crc = 0
+            });
+        }
+
+        std::for_each(std::execution::par, pieces.begin(), pieces.end(), [](Piece &piece) {
+            piece.crc = static_cast<uint32_t>(crc32(UINT32_C(0), piece.data, static_cast<uInt>(piece.size)));
+        });
+
+        uint32_t crc = 0;
+
+        for(const auto &piece: pieces) {
+            crc = static_cast<uint32_t>(crc32_combine(crc, piece.crc, static_cast<z_off_t>(piece.size)));
+        }
+
+        return crc;
+    }
+
     /*
     * This calculates as 32-bit value that can be appended to a block of data
     * with CRC-32 value of 'originalCRC32' to make the CRC-32 of the combined
@@ -0,0 +1,110 @@
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleHeader.h>
+
+#include <UnityAsset/Streams/Stream.h>
+
+#include <stdexcept>
+
+namespace UnityAsset {
+
+    AssetBundleHeader::AssetBundleHeader() : fileSize(0), directoryCompression(UnityCompressionType::None),
+        dataCompression(UnityCompressionType::None), dataOffset(0), totalCompressedSize(0), totalUncompressedSize(0) {
+
+    }
+
+    AssetBundleHeader::~AssetBundleHeader() = default;
+
+    AssetBundleHeader::AssetBundleHeader(AssetBundleHeader &&other) noexcept = default;
+
+    AssetBundleHeader &AssetBundleHeader::operator =(AssetBundleHeader &&other) noexcept = default;
+
+    AssetBundleHeader::AssetBundleHeader(const Stream &input) : AssetBundleHeader() {
+        auto stream = input.createView();
+
+        stream.setByteOrder(Stream::ByteOrder::MostSignificantFirst);
+
+        auto signature = stream.readNullTerminatedString();
+        if(signature != Signature)
+            throw std::runtime_error("AssetBundleHeader: bad signature");
+
+        uint32_t version;
+        stream >> version;
+
+        if(version != Version)
+            throw std::runtime_error("AssetBundleHeader: bad version");
+
+        unityVersion = stream.readNullTerminatedString();
+        unityRevision = stream.readNullTerminatedString();
+
+        stream >> fileSize;
+
+        if(fileSize > stream.length())
+            throw std::runtime_error("AssetBundleHeader: mismatched file size");
+
+        uint32_t compressedDirectoryLength;
+        uint32_t uncompressedDirectoryLength;
+        DirectoryFlags directoryFlags;
+        stream
+            >> compressedDirectoryLength
+            >> uncompressedDirectoryLength
+            >> directoryFlags;
+
+        auto directoryOptions = directoryCompressionOptions(directoryFlags);
+        if(directoryOptions != BlocksAndDirectoryInfoCombined && directoryOptions != (BlocksAndDirectoryInfoCombined | BlocksInfoAtTheEnd))
+            throw std::runtime_error("AssetBundleHeader: unsupported directory options");
+
+        directoryCompression = directoryCompressionType(directoryFlags);
+
+        Stream compressedDirectory;
+        uint64_t dataEndOffset;
+
+        if(directoryOptions & BlocksInfoAtTheEnd) {
+            /*
+             * The data immediately follows the header, and the directory
+             * is at the very end of the file.
+             */
+            if(fileSize < stream.position() || compressedDirectoryLength > fileSize - stream.position())
+                throw std::runtime_error("AssetBundleHeader: the directory is out of the bounds of the file");
+
+            dataOffset = stream.position();
+            compressedDirectory = stream.createView(fileSize - compressedDirectoryLength, compressedDirectoryLength);
+            dataEndOffset = fileSize - compressedDirectoryLength;
+        } else {
+            compressedDirectory = stream.createView(stream.position(), compressedDirectoryLength);
+            stream.setPosition(stream.position() + compressedDirectoryLength);
+
+            dataOffset = stream.position();
+            dataEndOffset = fileSize;
+        }
+
+        directory = AssetBundleDirectory(unityUncompress(std::move(compressedDirectory), directoryCompression, uncompressedDirectoryLength));
+
+        for(auto byte: directory.uncompressedDataHash)
+            if(byte != 0)
+                throw std::runtime_error("AssetBundleHeader: uncompressedDataHash is non-zero");
+
+        for(const auto &block: directory.blocks) {
+            totalCompressedSize += block.compressedSize;
+            totalUncompressedSize += block.uncompressedSize;
+
+            if((block.flags & ~UINT16_C(0x3F)) != 0) {
+                throw std::runtime_error("AssetBundleHeader: unsupported block flags");
+            }
+
+            auto type = static_cast<UnityCompressionType>(block.flags & UINT16_C(0x3F));
+
+            if(type != UnityCompressionType::None) {
+                dataCompression = type;
+            } else if(block.compressedSize != block.uncompressedSize) {
+                throw std::runtime_error("AssetBundleHeader: the sizes of an uncompressed block don't match");
+            }
+        }
+
+        if(dataOffset + totalCompressedSize != dataEndOffset)
+            throw std::runtime_error("AssetBundleHeader: total compressed length is inconsistent with the stream length");
+
+        for(const auto &file: directory.files) {
+            if(file.fileOffset > totalUncompressedSize || file.fileSize > totalUncompressedSize - file.fileOffset)
+                throw std::runtime_error("AssetBundleHeader: file is out of the bounds of the data");
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include <UnityAsset/SerializedAsset/DynamicObject.h>
+#include <UnityAsset/Streams/ByteSwap.h>
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace UnityAsset {
+
+    DynamicObject::DynamicObject(std::shared_ptr<const DynamicType> type, const Stream &data) :
+        m_type(std::move(type)), m_data(data),
+        m_swapByteOrder((data.byteOrder() == Stream::ByteOrder::LeastSignificantFirst) != (std::endian::native == std::endian::little)),
+        m_position(0) {
+
+        decode();
+    }
+
+    DynamicObject::DynamicObject(const SerializedType &type, const Stream &data) : DynamicObject(DynamicType::forType(type), data) {
+
+    }
+
+    DynamicObject::~DynamicObject() = default;
+
+    DynamicObject::DynamicObject(DynamicObject &&other) noexcept = default;
+
+    DynamicObject &DynamicObject::operator =(DynamicObject &&other) noexcept = default;
+
+    DynamicValue DynamicObject::root() const {
+        return DynamicValue(this, 0, static_cast<uint32_t>(0));
+    }
+
+    void DynamicObject::decode() {
+        const auto &operations = m_type->operations();
+
+        m_slots.resize(1);
+        decodeFields(0, operations.size(), 0);
+
+        if(m_position != m_data.length())
+            throw std::runtime_error("extra data after the expected end of the object");
+    }
+
+    size_t DynamicObject::decodeFields(size_t operation, size_t end, size_t slot) {
+        const auto &operations = m_type->operations();
+        const auto &nodes = m_type->nodes();
+
+        while(operation < end) {
+            const auto &op = operations[operation];
+
+            switch(op.code) {
+            case DynamicType::OperationCode::Fixed:
+                checkAvailable(op.extent);
+
+                for(uint32_t index = 0; index < op.count; index++) {
+                    m_slots[slot++] = Slot{
+                        .node = op.node + index,
+                        .count = 0,
+                        .position = m_position + nodes[op.node + index].offset
+                    };
+                }
+
+                m_position += op.extent;
+                operation++;
+                break;
+
+            case DynamicType::OperationCode::String:
+            {
+                auto length = readLength();
+                checkAvailable(length);
+
+                m_slots[slot++] = Slot{ .node = op.node, .count = static_cast<uint32_t>(length), .position = m_position };
+
+                m_position += length;
+                operation++;
+                break;
+            }
+
+            case DynamicType::OperationCode::FixedArray:
+            {
+                auto length = readLength();
+                if(op.extent != 0 && static_cast<size_t>(length) > (m_data.length() - m_position) / op.extent)
+                    throw std::runtime_error("array length exceeds the object data");
+
+                m_slots[slot++] = Slot{ .node = op.node, .count = static_cast<uint32_t>(length), .position = m_position };
+
+                m_position += static_cast<size_t>(length) * op.extent;
+                operation++;
+                break;
+            }
+
+            case DynamicType::OperationCode::Array:
+            {
+                /*
+                 * A variable-size element holds at least a length of its
+                 * own, which bounds the number of elements.
+                 */
+                auto length = readLength();
+                checkAvailable(length);
+
+                auto first = m_slots.size();
+                m_slots.resize(first + length);
+                m_slots[slot++] = Slot{ .node = op.node, .count = static_cast<uint32_t>(length), .position = first };
+
+                for(int32_t index = 0; index < length; index++) {
+                    decodeFields(operation + 1, op.extent, first + index);
+                }
+
+                operation = op.extent;
+                break;
+            }
+
+            case DynamicType::OperationCode::Struct:
+            {
+                auto first = m_slots.size();
+                m_slots.resize(first + op.count);
+                m_slots[slot++] = Slot{ .node = op.node, .count = op.count, .position = first };
+
+                decodeFields(operation + 1, op.extent, first);
+
+                operation = op.extent;
+                break;
+            }
+
+            case DynamicType::OperationCode::Align:
+                m_position = (m_position + 3) & ~static_cast<size_t>(3);
+                if(m_position > m_data.length())
+                    throw std::runtime_error("unexpected end of the object data");
+
+                operation++;
+                break;
+
+            case DynamicType::OperationCode::Unsupported:
+            default:
+                throw std::runtime_error("the object contains a node of the type '" + std::string(nodes[op.node].type) +
+                                         "' that can't be decoded from the type tree");
+            }
+        }
+
+        return slot;
+    }
+
+    int32_t DynamicObject::readLength() {
+        checkAvailable(sizeof(int32_t));
+
+        int32_t length;
+        memcpy(&length, m_data.data() + m_position, sizeof(length));
+        m_position += sizeof(length);
+
+        if(m_swapByteOrder)
+            length = byteSwap(length);
+
+        if(length < 0)
+            throw std::runtime_error("negative array length");
+
+        return length;
+    }
+
+    void DynamicObject::checkAvailable(size_t length) const {
+        if(length > m_data.length() - m_position)
+            throw std::runtime_error("unexpected end of the object data");
+    }
+}
@@ -0,0 +1,429 @@
+#include <UnityAsset/SerializedAsset/DynamicType.h>
+#include <UnityAsset/SerializedAsset/SerializedType.h>
+#include <UnityAsset/SerializedAsset/TypeTree.h>
+
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace UnityAsset {
+
+    struct PrimitiveType {
+        std::string_view name;
+        DynamicType::Kind kind;
+        uint32_t size;
+    };
+
+    static constexpr PrimitiveType PrimitiveTypes[]{
+        { "bool",               DynamicType::Kind::Bool,   1 },
+        { "SInt8",              DynamicType::Kind::Int8,   1 },
+        { "UInt8",              DynamicType::Kind::UInt8,  1 },
+        { "char",               DynamicType::Kind::UInt8,  1 },
+        { "SInt16",             DynamicType::Kind::Int16,  2 },
+        { "short",              DynamicType::Kind::Int16,  2 },
+        { "UInt16",             DynamicType::Kind::UInt16, 2 },
+        { "unsigned short",     DynamicType::Kind::UInt16, 2 },
+        { "SInt32",             DynamicType::Kind::Int32,  4 },
+        { "int",                DynamicType::Kind::Int32,  4 },
+        { "UInt32",             DynamicType::Kind::UInt32, 4 },
+        { "unsigned int",       DynamicType::Kind::UInt32, 4 },
+        { "Type*",              DynamicType::Kind::UInt32, 4 },
+        { "SInt64",             DynamicType::Kind::Int64,  8 },
+        { "long long",          DynamicType::Kind::Int64,  8 },
+        { "UInt64",             DynamicType::Kind::UInt64, 8 },
+        { "unsigned long long", DynamicType::Kind::UInt64, 8 },
+        { "FileSize",           DynamicType::Kind::UInt64, 8 },
+        { "float",              DynamicType::Kind::Float,  4 },
+        { "double",             DynamicType::Kind::Double, 8 },
+    };
+
+    class DynamicType::Compiler {
+    public:
+        Compiler(DynamicType &type, const TypeTree &tree);
+
+        void compile();
+
+    private:
+        std::string_view string(uint32_t offset) const;
+        bool isArray(uint32_t treeIndex) const;
+
+        uint32_t allocateNodes(size_t count);
+        void compileNode(uint32_t treeIndex, uint32_t nodeIndex);
+        void compileLeaf(uint32_t treeIndex, uint32_t nodeIndex);
+        void computeSize(uint32_t nodeIndex);
+
+        void emit(OperationCode code, uint32_t node, uint32_t count = 0, uint32_t extent = 0);
+        void emitNode(uint32_t nodeIndex);
+        void emitFields(uint32_t nodeIndex);
+
+        DynamicType &m_type;
+        const TypeTree &m_tree;
+        std::vector<std::vector<uint32_t>> m_children;
+    };
+
+    DynamicType::Compiler::Compiler(DynamicType &type, const TypeTree &tree) : m_type(type), m_tree(tree) {
+
+    }
+
+    void DynamicType::Compiler::compile() {
+        const auto &treeNodes = m_tree.m_Nodes;
+
+        if(treeNodes.empty() || treeNodes.front().m_Level != 0)
+            throw std::runtime_error("the type tree has no root node");
+
+        /*
+         * The nodes are in the pre-order, with the depth given by the
+         * level.
+         */
+        m_children.resize(treeNodes.size());
+
+        std::vector<uint32_t> parents{ 0 };
+
+        for(uint32_t index = 1; index < treeNodes.size(); index++) {
+            auto level = treeNodes[index].m_Level;
+
+            if(level == 0 || level > parents.size())
+                throw std::runtime_error("the type tree has an inconsistent node structure");
+
+            parents.resize(level);
+            m_children[parents.back()].emplace_back(index);
+            parents.emplace_back(index);
+        }
+
+        const auto &buffer = m_tree.m_StringBuffer;
+        m_type.m_strings.assign(buffer.data(), buffer.data() + buffer.length());
+
+        allocateNodes(1);
+        compileNode(0, 0);
+        computeSize(0);
+
+        emitNode(0);
+    }
+
+    std::string_view DynamicType::Compiler::string(uint32_t offset) const {
+        auto string = m_tree.string(offset);
+
+        /*
+         * The node strings from the string buffer are repointed to the copy
+         * of it, so that the type doesn't refer to the tree.
+         */
+        auto buffer = reinterpret_cast<const char *>(m_tree.m_StringBuffer.data());
+        if(string.data() >= buffer && string.data() < buffer + m_tree.m_StringBuffer.length())
+            return std::string_view(m_type.m_strings.data() + (string.data() - buffer), string.size());
+
+        return string;
+    }
+
+    bool DynamicType::Compiler::isArray(uint32_t treeIndex) const {
+        return (m_tree.m_Nodes[treeIndex].m_TypeFlags & 1) != 0;
+    }
+
+    uint32_t DynamicType::Compiler::allocateNodes(size_t count) {
+        auto first = static_cast<uint32_t>(m_type.m_nodes.size());
+
+        m_type.m_nodes.resize(first + count);
+
+        return first;
+    }
+
+    void DynamicType::Compiler::compileNode(uint32_t treeIndex, uint32_t nodeIndex) {
+        const auto &treeNode = m_tree.m_Nodes[treeIndex];
+        const auto &children = m_children[treeIndex];
+
+        {
+            auto &node = m_type.m_nodes[nodeIndex];
+            node.type = string(treeNode.m_TypeStrOffset);
+            node.name = string(treeNode.m_NameStrOffset);
+            node.align = (treeNode.m_MetaFlag & 0x4000) != 0;
+            node.size = VariableSize;
+            node.offset = 0;
+            node.firstChild = 0;
+            node.childCount = 0;
+        }
+
+        /*
+         * A vector, map, set or string is a node with a single Array child,
+         * and the two are folded together.
+         */
+        auto arrayIndex = treeIndex;
+        if(!isArray(treeIndex) && children.size() == 1 && isArray(children.front())) {
+            arrayIndex = children.front();
+
+            if(m_tree.m_Nodes[arrayIndex].m_MetaFlag & 0x4000)
+                m_type.m_nodes[nodeIndex].align = true;
+        }
+
+        if(isArray(arrayIndex)) {
+            const auto &arrayChildren = m_children[arrayIndex];
+            if(arrayChildren.size() != 2)
+                throw std::runtime_error("an array node in the type tree doesn't have the size and the data");
+
+            if(m_type.m_nodes[nodeIndex].type == "string") {
+                m_type.m_nodes[nodeIndex].kind = Kind::String;
+            } else {
+                auto element = allocateNodes(1);
+
+                auto &node = m_type.m_nodes[nodeIndex];
+                node.kind = Kind::Array;
+                node.firstChild = element;
+                node.childCount = 1;
+
+                compileNode(arrayChildren[1], element);
+            }
+        } else if(children.empty()) {
+            compileLeaf(treeIndex, nodeIndex);
+        } else {
+            auto first = allocateNodes(children.size());
+
+            auto &node = m_type.m_nodes[nodeIndex];
+            node.kind = Kind::Struct;
+            node.firstChild = first;
+            node.childCount = static_cast<uint32_t>(children.size());
+
+            for(uint32_t index = 0; index < children.size(); index++) {
+                compileNode(children[index], first + index);
+            }
+        }
+    }
+
+    void DynamicType::Compiler::compileLeaf(uint32_t treeIndex, uint32_t nodeIndex) {
+        auto &node = m_type.m_nodes[nodeIndex];
+
+        for(const auto &primitive: PrimitiveTypes) {
+            if(primitive.name == node.type) {
+                node.kind = primitive.kind;
+                node.size = primitive.size;
+                return;
+            }
+        }
+
+        /*
+         * Leaves of an unknown type are taken as unsigned integers of their
+         * size, or as empty structures if they're empty.
+         */
+        switch(m_tree.m_Nodes[treeIndex].m_ByteSize) {
+        case 0:
+            node.kind = Kind::Struct;
+            node.size = 0;
+            break;
+
+        case 1:
+            node.kind = Kind::UInt8;
+            node.size = 1;
+            break;
+
+        case 2:
+            node.kind = Kind::UInt16;
+            node.size = 2;
+            break;
+
+        case 4:
+            node.kind = Kind::UInt32;
+            node.size = 4;
+            break;
+
+        case 8:
+            node.kind = Kind::UInt64;
+            node.size = 8;
+            break;
+
+        default:
+            node.kind = Kind::Unsupported;
+            break;
+        }
+    }
+
+    void DynamicType::Compiler::computeSize(uint32_t nodeIndex) {
+        auto node = m_type.m_nodes[nodeIndex];
+
+        for(uint32_t child = node.firstChild; child < node.firstChild + node.childCount; child++) {
+            computeSize(child);
+        }
+
+        if(node.kind != Kind::Struct || node.childCount == 0)
+            return;
+
+        /*
+         * A structure is fixed-size if all of its fields are, and nothing
+         * inside it is aligned, since the alignment depends on where the
+         * structure is.
+         */
+        uint32_t size = 0;
+
+        for(uint32_t child = node.firstChild; child < node.firstChild + node.childCount; child++) {
+            auto &field = m_type.m_nodes[child];
+
+            if(!field.isFixedSize() || field.align)
+                return;
+
+            field.offset = size;
+            size += field.size;
+        }
+
+        m_type.m_nodes[nodeIndex].size = size;
+    }
+
+    void DynamicType::Compiler::emit(OperationCode code, uint32_t node, uint32_t count, uint32_t extent) {
+        m_type.m_operations.emplace_back(Operation{ .code = code, .node = node, .count = count, .extent = extent });
+    }
+
+    void DynamicType::Compiler::emitNode(uint32_t nodeIndex) {
+        const auto &node = m_type.m_nodes[nodeIndex];
+
+        if(node.isFixedSize()) {
+            emit(OperationCode::Fixed, nodeIndex, 1, node.size);
+        } else {
+            switch(node.kind) {
+            case Kind::String:
+                emit(OperationCode::String, nodeIndex);
+                break;
+
+            case Kind::Array:
+            {
+                const auto &element = m_type.m_nodes[node.firstChild];
+
+                if(element.isFixedSize() && !element.align) {
+                    emit(OperationCode::FixedArray, nodeIndex, 0, element.size);
+                } else {
+                    auto operation = m_type.m_operations.size();
+                    emit(OperationCode::Array, nodeIndex);
+                    emitNode(node.firstChild);
+                    m_type.m_operations[operation].extent = static_cast<uint32_t>(m_type.m_operations.size());
+                }
+
+                break;
+            }
+
+            case Kind::Struct:
+            {
+                auto operation = m_type.m_operations.size();
+                emit(OperationCode::Struct, nodeIndex, node.childCount);
+                emitFields(nodeIndex);
+                m_type.m_operations[operation].extent = static_cast<uint32_t>(m_type.m_operations.size());
+                break;
+            }
+
+            default:
+                emit(OperationCode::Unsupported, nodeIndex);
+                break;
+            }
+        }
+
+        if(m_type.m_nodes[nodeIndex].align)
+            emit(OperationCode::Align, nodeIndex);
+    }
+
+    void DynamicType::Compiler::emitFields(uint32_t nodeIndex) {
+        auto first = m_type.m_nodes[nodeIndex].firstChild;
+        auto end = first + m_type.m_nodes[nodeIndex].childCount;
+
+        for(auto child = first; child < end;) {
+            if(!m_type.m_nodes[child].isFixedSize()) {
+                emitNode(child);
+                child++;
+                continue;
+            }
+
+            /*
+             * Merge the run of the fixed-size fields, up to and including
+             * the first one that is aligned after.
+             */
+            auto runStart = child;
+            uint32_t runSize = 0;
+            bool aligned = false;
+
+            while(child < end && m_type.m_nodes[child].isFixedSize() && !aligned) {
+                auto &field = m_type.m_nodes[child];
+
+                field.offset = runSize;
+                runSize += field.size;
+                aligned = field.align;
+                child++;
+            }
+
+            emit(OperationCode::Fixed, runStart, child - runStart, runSize);
+
+            if(aligned)
+                emit(OperationCode::Align, child - 1);
+        }
+    }
+
+    DynamicType::DynamicType(const TypeTree &tree) {
+        Compiler compiler(*this, tree);
+        compiler.compile();
+    }
+
+    DynamicType::~DynamicType() = default;
+
+    struct DynamicTypeCache {
+        std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<const DynamicType>> types;
+    };
+
+    static DynamicTypeCache &dynamicTypeCache() {
+        /*
+         * Intentionally never destroyed, like the other process-wide
+         * caches.
+         */
+        static auto cache = new DynamicTypeCache;
+
+        return *cache;
+    }
+
+    std::shared_ptr<const DynamicType> DynamicType::forType(const SerializedType &type) {
+        if(!type.m_Type.has_value())
+            throw std::runtime_error("the serialized type has no type tree");
+
+        return forTypeTree(*type.m_Type);
+    }
+
+    std::shared_ptr<const DynamicType> DynamicType::forTypeTree(const TypeTree &tree) {
+        /*
+         * The type trees are identified by their contents, so that the
+         * same types in different files share the compiled type.
+         */
+        std::string key;
+        key.reserve(tree.m_Nodes.size() * 28 + tree.m_StringBuffer.length());
+
+        auto append = [&key](const auto &value) {
+            key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        };
+
+        for(const auto &node: tree.m_Nodes) {
+            append(node.m_Level);
+            append(node.m_TypeFlags);
+            append(node.m_TypeStrOffset);
+            append(node.m_NameStrOffset);
+            append(node.m_ByteSize);
+            append(node.m_MetaFlag);
+        }
+
+        key.append(reinterpret_cast<const char *>(tree.m_StringBuffer.data()), tree.m_StringBuffer.length());
+
+        auto &cache = dynamicTypeCache();
+
+        {
+            std::unique_lock<std::mutex> locker(cache.mutex);
+
+            auto it = cache.types.find(key);
+            if(it != cache.types.end())
+                return it->second;
+        }
+
+        auto type = std::make_shared<const DynamicType>(tree);
+
+        std::unique_lock<std::mutex> locker(cache.mutex);
+
+        return cache.types.emplace(std::move(key), std::move(type)).first->second;
+    }
+
+    void DynamicType::clearCache() {
+        auto &cache = dynamicTypeCache();
+
+        std::unique_lock<std::mutex> locker(cache.mutex);
+
+        cache.types.clear();
+    }
+}
@@ -0,0 +1,230 @@
+#include <UnityAsset/SerializedAsset/DynamicValue.h>
+#include <UnityAsset/SerializedAsset/DynamicObject.h>
+#include <UnityAsset/Streams/ByteSwap.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace UnityAsset {
+
+    DynamicValue::DynamicValue(const DynamicObject *object, uint32_t node, uint32_t slot) :
+        m_object(object), m_node(node), m_slot(slot), m_data(nullptr) {
+
+        if(this->node().isFixedSize())
+            m_data = object->m_data.data() + object->m_slots[slot].position;
+    }
+
+    DynamicValue::DynamicValue(const DynamicObject *object, uint32_t node, const unsigned char *data) :
+        m_object(object), m_node(node), m_slot(0), m_data(data) {
+
+    }
+
+    const DynamicType::Node &DynamicValue::node() const {
+        return m_object->type().nodes()[m_node];
+    }
+
+    bool DynamicValue::isElementFixedSize() const {
+        const auto &element = m_object->type().nodes()[node().firstChild];
+
+        return element.isFixedSize() && !element.align;
+    }
+
+    size_t DynamicValue::size() const {
+        const auto &node = this->node();
+
+        switch(node.kind) {
+        case DynamicType::Kind::Struct:
+            return node.childCount;
+
+        case DynamicType::Kind::Array:
+        case DynamicType::Kind::String:
+            return m_object->m_slots[m_slot].count;
+
+        default:
+            return 0;
+        }
+    }
+
+    DynamicValue DynamicValue::operator [](size_t index) const {
+        const auto &node = this->node();
+
+        if(index >= size())
+            throw std::out_of_range("dynamic value index is out of range");
+
+        if(node.kind == DynamicType::Kind::Struct) {
+            auto field = node.firstChild + static_cast<uint32_t>(index);
+
+            if(m_data)
+                return DynamicValue(m_object, field, m_data + m_object->type().nodes()[field].offset);
+
+            return DynamicValue(m_object, field, static_cast<uint32_t>(m_object->m_slots[m_slot].position + index));
+
+        } else if(node.kind == DynamicType::Kind::Array) {
+            const auto &slot = m_object->m_slots[m_slot];
+
+            if(isElementFixedSize()) {
+                const auto &element = m_object->type().nodes()[node.firstChild];
+
+                return DynamicValue(m_object, node.firstChild, m_object->m_data.data() + slot.position + index * element.size);
+            }
+
+            return DynamicValue(m_object, node.firstChild, static_cast<uint32_t>(slot.position + index));
+
+        } else {
+            throw std::logic_error("only the structures and the arrays can be indexed");
+        }
+    }
+
+    DynamicValue DynamicValue::operator [](std::string_view name) const {
+        auto value = find(name);
+        if(!value.has_value())
+            throw std::runtime_error("no field named '" + std::string(name) + "' in '" + std::string(typeName()) + "'");
+
+        return *value;
+    }
+
+    std::optional<DynamicValue> DynamicValue::find(std::string_view name) const {
+        const auto &node = this->node();
+
+        if(node.kind != DynamicType::Kind::Struct)
+            return std::nullopt;
+
+        const auto &nodes = m_object->type().nodes();
+
+        for(uint32_t index = 0; index < node.childCount; index++) {
+            if(nodes[node.firstChild + index].name == name)
+                return (*this)[index];
+        }
+
+        return std::nullopt;
+    }
+
+    template<typename T>
+    static T readPrimitive(const unsigned char *data, bool swapByteOrder) {
+        T value;
+        memcpy(&value, data, sizeof(value));
+
+        if(swapByteOrder)
+            value = byteSwap(value);
+
+        return value;
+    }
+
+    int64_t DynamicValue::toInt() const {
+        switch(kind()) {
+        case DynamicType::Kind::Float:
+        case DynamicType::Kind::Double:
+            return static_cast<int64_t>(toFloat());
+
+        case DynamicType::Kind::UInt64:
+            return static_cast<int64_t>(toUInt());
+
+        default:
+            break;
+        }
+
+        auto swap = m_object->m_swapByteOrder;
+
+        switch(kind()) {
+        case DynamicType::Kind::Bool:
+        case DynamicType::Kind::UInt8:
+            return readPrimitive<uint8_t>(m_data, swap);
+
+        case DynamicType::Kind::Int8:
+            return readPrimitive<int8_t>(m_data, swap);
+
+        case DynamicType::Kind::Int16:
+            return readPrimitive<int16_t>(m_data, swap);
+
+        case DynamicType::Kind::UInt16:
+            return readPrimitive<uint16_t>(m_data, swap);
+
+        case DynamicType::Kind::Int32:
+            return readPrimitive<int32_t>(m_data, swap);
+
+        case DynamicType::Kind::UInt32:
+            return readPrimitive<uint32_t>(m_data, swap);
+
+        case DynamicType::Kind::Int64:
+            return readPrimitive<int64_t>(m_data, swap);
+
+        default:
+            throw std::logic_error("the dynamic value is not a number");
+        }
+    }
+
+    uint64_t DynamicValue::toUInt() const {
+        if(kind() == DynamicType::Kind::UInt64)
+            return readPrimitive<uint64_t>(m_data, m_object->m_swapByteOrder);
+
+        return static_cast<uint64_t>(toInt());
+    }
+
+    double DynamicValue::toFloat() const {
+        switch(kind()) {
+        case DynamicType::Kind::Float:
+            return std::bit_cast<float>(readPrimitive<uint32_t>(m_data, m_object->m_swapByteOrder));
+
+        case DynamicType::Kind::Double:
+            return std::bit_cast<double>(readPrimitive<uint64_t>(m_data, m_object->m_swapByteOrder));
+
+        case DynamicType::Kind::UInt64:
+            return static_cast<double>(toUInt());
+
+        default:
+            return static_cast<double>(toInt());
+        }
+    }
+
+    bool DynamicValue::toBool() const {
+        return toInt() != 0;
+    }
+
+    std::string_view DynamicValue::toString() const {
+        if(kind() != DynamicType::Kind::String)
+            throw std::logic_error("the dynamic value is not a string");
+
+        return std::string_view(reinterpret_cast<const char *>(data()), dataSize());
+    }
+
+    const unsigned char *DynamicValue::data() const {
+        if(m_data)
+            return m_data;
+
+        switch(kind()) {
+        case DynamicType::Kind::String:
+            return m_object->m_data.data() + m_object->m_slots[m_slot].position;
+
+        case DynamicType::Kind::Array:
+            if(isElementFixedSize())
+                return m_object->m_data.data() + m_object->m_slots[m_slot].position;
+
+            [[fallthrough]];
+
+        default:
+            throw std::logic_error("the dynamic value has no contiguous data");
+        }
+    }
+
+    size_t DynamicValue::dataSize() const {
+        const auto &node = this->node();
+
+        if(m_data)
+            return node.size;
+
+        switch(node.kind) {
+        case DynamicType::Kind::String:
+            return m_object->m_slots[m_slot].count;
+
+        case DynamicType::Kind::Array:
+            if(isElementFixedSize())
+                return static_cast<size_t>(m_object->m_slots[m_slot].count) * m_object->type().nodes()[node.firstChild].size;
+
+            [[fallthrough]];
+
+        default:
+            throw std::logic_error("the dynamic value has no contiguous data");
+        }
+    }
+}
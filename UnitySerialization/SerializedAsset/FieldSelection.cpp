@@ -0,0 +1,26 @@
+#include <UnityAsset/SerializedAsset/FieldSelection.h>
+
+namespace UnityAsset {
+
+    FieldSelection::FieldSelection() = default;
+
+    FieldSelection::FieldSelection(std::initializer_list<std::string_view> fields) {
+        for(auto field: fields) {
+            add(field);
+        }
+    }
+
+    FieldSelection::~FieldSelection() = default;
+
+    FieldSelection::FieldSelection(const FieldSelection &other) = default;
+
+    FieldSelection &FieldSelection::operator =(const FieldSelection &other) = default;
+
+    FieldSelection::FieldSelection(FieldSelection &&other) noexcept = default;
+
+    FieldSelection &FieldSelection::operator =(FieldSelection &&other) noexcept = default;
+
+    void FieldSelection::add(std::string_view field) {
+        m_fields.emplace(field);
+    }
+}
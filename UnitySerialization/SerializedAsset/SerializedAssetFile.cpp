@@ -1,6 +1,7 @@
 #include <UnityAsset/SerializedAsset/SerializedAssetFile.h>
 
 #include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/Streams/SegmentedOutput.h>
 
 #include <limits>
 
@@ -57,6 +58,11 @@ namespace UnityAsset {
         if(fileSize != stream.length())
             throw std::runtime_error("SerializedAssetFile: file size in the header is inconsistent with the stream length");
 
+        /*
+         * All of the metadata is parsed right away.
+         */
+        stream.prefetch(stream.position(), metadataSize);
+
         auto metadataStream = stream.createView(stream.position(), metadataSize);
         metadataStream.setByteOrder(Stream::ByteOrder::LeastSignificantFirst); // MSB first if (flags & 1) == 1
 
@@ -120,6 +126,14 @@ namespace UnityAsset {
     }
 
     void SerializedAssetFile::serialize(Stream &output) const {
+        SegmentedOutput segments;
+        serialize(segments);
+
+        output.setByteOrder(Stream::ByteOrder::MostSignificantFirst);
+        segments.writeTo(output);
+    }
+
+    void SerializedAssetFile::serialize(SegmentedOutput &output) const {
         /*
          * Begin by serializing the metadata.
          */
@@ -183,7 +197,12 @@ namespace UnityAsset {
 
         metadataStream.writeNullTerminatedString(userInformation);
 
-        output.setByteOrder(Stream::ByteOrder::MostSignificantFirst);
+        /*
+         * Everything up to the object data is assembled in memory, and the
+         * object data is only referenced.
+         */
+        Stream header;
+        header.setByteOrder(Stream::ByteOrder::MostSignificantFirst);
 
         if(metadataStream.length() > std::numeric_limits<int32_t>::max())
             throw std::runtime_error("the metadata stream is too long to represent");
@@ -195,80 +214,82 @@ namespace UnityAsset {
              * Dummy 32-bit values that are always zero:
              */
 
-            output << static_cast<uint32_t>(0); // unused metadata size
-            output << static_cast<uint32_t>(0); // narrow file size
+            header << static_cast<uint32_t>(0); // unused metadata size
+            header << static_cast<uint32_t>(0); // narrow file size
         } else {
-            fileSizeOffset = output.position();
-            output << static_cast<uint32_t>(0); // file size - will be fixed later
+            fileSizeOffset = header.position();
+            header << static_cast<uint32_t>(0); // file size - will be fixed later
         }
 
-        output << assetVersion;
+        header << assetVersion;
 
         size_t dataStartOffset = 0;
         if(assetVersion >= 22) {
             /*
              * Dummy 32-bit data start offset that's always zero
              */
-            output << static_cast<uint32_t>(0);
+            header << static_cast<uint32_t>(0);
         } else {
-            dataStartOffset = output.position();
-            output << static_cast<uint32_t>(0); // data start offset - will be fixed later
+            dataStartOffset = header.position();
+            header << static_cast<uint32_t>(0); // data start offset - will be fixed later
         }
 
-        output << static_cast<uint32_t>(0); // flags - always 0
+        header << static_cast<uint32_t>(0); // flags - always 0
 
         if(assetVersion >= 22) {
             /*
              * Metadata length - still 32-bit, but relocated here.
              */
-            output << static_cast<uint32_t>(metadataStream.length());
+            header << static_cast<uint32_t>(metadataStream.length());
 
             /*
             * Actual 64-bit lengths and offsets.
             */
 
-            fileSizeOffset = output.position();
-            output << static_cast<uint64_t>(0); // file size - will be fixed later
+            fileSizeOffset = header.position();
+            header << static_cast<uint64_t>(0); // file size - will be fixed later
 
-            dataStartOffset = output.position();
-            output << static_cast<uint64_t>(0); // data start offset - will be fixed later
+            dataStartOffset = header.position();
+            header << static_cast<uint64_t>(0); // data start offset - will be fixed later
 
-            output << static_cast<uint64_t>(0); // This field seems to always be zero
+            header << static_cast<uint64_t>(0); // This field seems to always be zero
         }
 
-        output.writeData(metadataStream.data(), metadataStream.length());
+        header.writeData(metadataStream.data(), metadataStream.length());
 
-        if(output.position() < 4096)
-            output.setPosition(4096);
+        if(header.position() < 4096)
+            header.setPosition(4096);
         else
-            output.alignPosition(16);
+            header.alignPosition(16);
 
-        size_t dataAreaOffset = output.position();
-        output.setPosition(dataStartOffset);
+        size_t dataAreaOffset = header.position();
+        header.setPosition(dataStartOffset);
 
         if(assetVersion >= 22) {
 
-            output << static_cast<uint64_t>(dataAreaOffset);
+            header << static_cast<uint64_t>(dataAreaOffset);
         } else {
             if(dataAreaOffset > std::numeric_limits<int32_t>::max()) {
                 throw std::logic_error("the asset is too long for the version 21 with the 32-bit sizes and offsets");
             }
 
-            output << static_cast<uint32_t>(dataAreaOffset);
+            header << static_cast<uint32_t>(dataAreaOffset);
         }
 
-        output.setPosition(dataAreaOffset);
-
+        /*
+         * The objects are laid out the same way as the output is going to be
+         * written, so that the file size is known up front.
+         */
+        size_t fileSize = dataAreaOffset;
         for(const auto &object: m_Objects) {
-            output.alignPosition(16);
-            output.writeData(object.objectData.data(), object.objectData.length());
+            fileSize = (fileSize + 15) & ~15;
+            fileSize += object.objectData.length();
         }
 
-        auto fileSize = output.position();
-        output.setPosition(fileSizeOffset);
+        header.setPosition(fileSizeOffset);
 
         if(assetVersion >= 22) {
-            output << static_cast<uint64_t>(fileSize);
+            header << static_cast<uint64_t>(fileSize);
 
         } else {
             if(fileSize > std::numeric_limits<int32_t>::max()) {
@@ -276,9 +297,19 @@ namespace UnityAsset {
             }
 
 
-            output << static_cast<uint32_t>(fileSize);
+            header << static_cast<uint32_t>(fileSize);
         }
 
-        output.setPosition(fileSize);
+        output.append(header);
+
+        size_t position = dataAreaOffset;
+        for(const auto &object: m_Objects) {
+            auto alignedPosition = (position + 15) & ~15;
+            output.appendZeroes(alignedPosition - position);
+
+            output.append(object.objectData);
+
+            position = alignedPosition + object.objectData.length();
+        }
     }
 }
@@ -1,8 +1,128 @@
 #include <UnityAsset/SerializedAsset/TypeTree.h>
 #include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/Streams/StreamReader.h>
+#include <UnityAsset/Streams/StreamWriter.h>
+
+#include <cstring>
+#include <stdexcept>
 
 namespace UnityAsset {
 
+    /*
+     * The strings built into Unity that the type trees refer to with the
+     * high bit of the offset set. Same as classdb/unity_dictionary.bin.
+     */
+    static constexpr char CommonStrings[] =
+        "AABB\0"
+        "AnimationClip\0"
+        "AnimationCurve\0"
+        "AnimationState\0"
+        "Array\0"
+        "Base\0"
+        "BitField\0"
+        "bitset\0"
+        "bool\0"
+        "char\0"
+        "ColorRGBA\0"
+        "Component\0"
+        "data\0"
+        "deque\0"
+        "double\0"
+        "dynamic_array\0"
+        "FastPropertyName\0"
+        "first\0"
+        "float\0"
+        "Font\0"
+        "GameObject\0"
+        "Generic Mono\0"
+        "GradientNEW\0"
+        "GUID\0"
+        "GUIStyle\0"
+        "int\0"
+        "list\0"
+        "long long\0"
+        "map\0"
+        "Matrix4x4f\0"
+        "MdFour\0"
+        "MonoBehaviour\0"
+        "MonoScript\0"
+        "m_ByteSize\0"
+        "m_Curve\0"
+        "m_EditorClassIdentifier\0"
+        "m_EditorHideFlags\0"
+        "m_Enabled\0"
+        "m_ExtensionPtr\0"
+        "m_GameObject\0"
+        "m_Index\0"
+        "m_IsArray\0"
+        "m_IsStatic\0"
+        "m_MetaFlag\0"
+        "m_Name\0"
+        "m_ObjectHideFlags\0"
+        "m_PrefabInternal\0"
+        "m_PrefabParentObject\0"
+        "m_Script\0"
+        "m_StaticEditorFlags\0"
+        "m_Type\0"
+        "m_Version\0"
+        "Object\0"
+        "pair\0"
+        "PPtr<Component>\0"
+        "PPtr<GameObject>\0"
+        "PPtr<Material>\0"
+        "PPtr<MonoBehaviour>\0"
+        "PPtr<MonoScript>\0"
+        "PPtr<Object>\0"
+        "PPtr<Prefab>\0"
+        "PPtr<Sprite>\0"
+        "PPtr<TextAsset>\0"
+        "PPtr<Texture>\0"
+        "PPtr<Texture2D>\0"
+        "PPtr<Transform>\0"
+        "Prefab\0"
+        "Quaternionf\0"
+        "Rectf\0"
+        "RectInt\0"
+        "RectOffset\0"
+        "second\0"
+        "set\0"
+        "short\0"
+        "size\0"
+        "SInt16\0"
+        "SInt32\0"
+        "SInt64\0"
+        "SInt8\0"
+        "staticvector\0"
+        "string\0"
+        "TextAsset\0"
+        "TextMesh\0"
+        "Texture\0"
+        "Texture2D\0"
+        "Transform\0"
+        "TypelessData\0"
+        "UInt16\0"
+        "UInt32\0"
+        "UInt64\0"
+        "UInt8\0"
+        "unsigned int\0"
+        "unsigned long long\0"
+        "unsigned short\0"
+        "vector\0"
+        "Vector2f\0"
+        "Vector3f\0"
+        "Vector4f\0"
+        "m_ScriptingClassIdentifier\0"
+        "Gradient\0"
+        "Type*\0"
+        "int2_storage\0"
+        "int3_storage\0"
+        "BoundsInt\0"
+        "m_CorrespondingSourceObject\0"
+        "m_PrefabInstance\0"
+        "m_PrefabAsset\0"
+        "FileSize\0"
+        "Hash128\0";
+
     TypeTree::TypeTree(Stream &stream, bool isRefType) {
         int32_t numberOfNodes;
         int32_t stringBufferSize;
@@ -10,8 +130,11 @@ namespace UnityAsset {
         stream >> numberOfNodes >> stringBufferSize;
 
         m_Nodes.reserve(numberOfNodes);
-        for(int32_t index = 0; index < numberOfNodes; index++) {
-            m_Nodes.emplace_back(stream);
+
+        if(stream.byteOrder() == Stream::ByteOrder::LeastSignificantFirst) {
+            readNodes<Stream::ByteOrder::LeastSignificantFirst>(stream, numberOfNodes);
+        } else {
+            readNodes<Stream::ByteOrder::MostSignificantFirst>(stream, numberOfNodes);
         }
 
         m_StringBuffer = stream.createView(stream.position(), stringBufferSize);
@@ -36,6 +159,47 @@ namespace UnityAsset {
         }
     }
 
+    template<Stream::ByteOrder Order>
+    void TypeTree::readNodes(Stream &stream, int32_t numberOfNodes) {
+        StreamReader<Order> reader(stream);
+
+        for(int32_t index = 0; index < numberOfNodes; index++) {
+            m_Nodes.emplace_back(reader);
+        }
+    }
+
+    template<Stream::ByteOrder Order>
+    void TypeTree::writeNodes(Stream &stream) const {
+        StreamWriter<Order> writer(stream);
+
+        for(const auto &node: m_Nodes) {
+            node.serialize(writer);
+        }
+    }
+
+    std::string_view TypeTree::string(uint32_t offset) const {
+        const char *strings;
+        size_t length;
+
+        if(offset & 0x80000000U) {
+            strings = CommonStrings;
+            length = sizeof(CommonStrings) - 1;
+            offset &= 0x7FFFFFFFU;
+        } else {
+            strings = reinterpret_cast<const char *>(m_StringBuffer.data());
+            length = m_StringBuffer.length();
+        }
+
+        if(offset >= length)
+            throw std::runtime_error("type tree string offset is out of range");
+
+        auto end = static_cast<const char *>(memchr(strings + offset, 0, length - offset));
+        if(end == nullptr)
+            throw std::runtime_error("the null terminator was not found");
+
+        return std::string_view(strings + offset, end);
+    }
+
     TypeTree::~TypeTree() = default;
 
     TypeTree::TypeTree(TypeTree &&other) noexcept = default;
@@ -47,8 +211,10 @@ namespace UnityAsset {
             << static_cast<int32_t>(m_Nodes.size())
             << static_cast<int32_t>(m_StringBuffer.length());
 
-        for(const auto &node: m_Nodes) {
-            node.serialize(stream);
+        if(stream.byteOrder() == Stream::ByteOrder::LeastSignificantFirst) {
+            writeNodes<Stream::ByteOrder::LeastSignificantFirst>(stream);
+        } else {
+            writeNodes<Stream::ByteOrder::MostSignificantFirst>(stream);
         }
 
         stream.writeData(m_StringBuffer.data(), m_StringBuffer.length());
@@ -1,11 +1,24 @@
 #include <UnityAsset/SerializedAsset/TypeTreeNode.h>
 
 #include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/Streams/StreamReader.h>
+#include <UnityAsset/Streams/StreamWriter.h>
 
 namespace UnityAsset {
 
     TypeTreeNode::TypeTreeNode(Stream &stream) {
-        stream
+        if(stream.byteOrder() == Stream::ByteOrder::LeastSignificantFirst) {
+            StreamReader<Stream::ByteOrder::LeastSignificantFirst> reader(stream);
+            *this = TypeTreeNode(reader);
+        } else {
+            StreamReader<Stream::ByteOrder::MostSignificantFirst> reader(stream);
+            *this = TypeTreeNode(reader);
+        }
+    }
+
+    template<Stream::ByteOrder Order>
+    TypeTreeNode::TypeTreeNode(StreamReader<Order> &reader) {
+        reader
             >> m_Version
             >> m_Level
             >> m_TypeFlags
@@ -17,6 +30,9 @@ namespace UnityAsset {
             >> m_RefTypeHash;
     }
 
+    template TypeTreeNode::TypeTreeNode(StreamReader<Stream::ByteOrder::LeastSignificantFirst> &reader);
+    template TypeTreeNode::TypeTreeNode(StreamReader<Stream::ByteOrder::MostSignificantFirst> &reader);
+
     TypeTreeNode::~TypeTreeNode() = default;
 
     TypeTreeNode::TypeTreeNode(TypeTreeNode &&other) noexcept = default;
@@ -24,7 +40,18 @@ namespace UnityAsset {
     TypeTreeNode &TypeTreeNode::operator =(TypeTreeNode &&other) noexcept = default;
 
     void TypeTreeNode::serialize(Stream &stream) const {
-        stream
+        if(stream.byteOrder() == Stream::ByteOrder::LeastSignificantFirst) {
+            StreamWriter<Stream::ByteOrder::LeastSignificantFirst> writer(stream);
+            serialize(writer);
+        } else {
+            StreamWriter<Stream::ByteOrder::MostSignificantFirst> writer(stream);
+            serialize(writer);
+        }
+    }
+
+    template<Stream::ByteOrder Order>
+    void TypeTreeNode::serialize(StreamWriter<Order> &writer) const {
+        writer
             << m_Version
             << m_Level
             << m_TypeFlags
@@ -35,5 +62,8 @@ namespace UnityAsset {
             << m_MetaFlag
             << m_RefTypeHash;
     }
+
+    template void TypeTreeNode::serialize(StreamWriter<Stream::ByteOrder::LeastSignificantFirst> &writer) const;
+    template void TypeTreeNode::serialize(StreamWriter<Stream::ByteOrder::MostSignificantFirst> &writer) const;
 }
 
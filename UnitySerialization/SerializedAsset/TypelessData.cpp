@@ -0,0 +1,40 @@
+#include <UnityAsset/SerializedAsset/TypelessData.h>
+
+namespace UnityAsset {
+
+    TypelessData::TypelessData() = default;
+
+    TypelessData::TypelessData(std::vector<uint8_t> &&data) : m_data(std::move(data)) {
+
+    }
+
+    TypelessData::TypelessData(const Stream &view) : m_view(view) {
+
+    }
+
+    TypelessData::~TypelessData() = default;
+
+    TypelessData::TypelessData(const TypelessData &other) = default;
+
+    TypelessData &TypelessData::operator =(const TypelessData &other) = default;
+
+    TypelessData::TypelessData(TypelessData &&other) noexcept = default;
+
+    TypelessData &TypelessData::operator =(TypelessData &&other) noexcept = default;
+
+    TypelessData &TypelessData::operator =(std::vector<uint8_t> &&data) {
+        m_view.reset();
+        m_data = std::move(data);
+
+        return *this;
+    }
+
+    std::vector<uint8_t> &TypelessData::mutableData() {
+        if(m_view) {
+            m_data.assign(m_view->data(), m_view->data() + m_view->length());
+            m_view.reset();
+        }
+
+        return m_data;
+    }
+}
@@ -4,8 +4,8 @@
 
 namespace UnityAsset {
     StreamedResourceManipulator::StreamedResourceManipulator(AssetBundleEntry &backingFile) : m_backingFile(backingFile) {
-        if(backingFile.data().length() != 0) {
-            m_unconsumedRanges.emplace_back(0, backingFile.data().length());
+        if(backingFile.size() != 0) {
+            m_unconsumedRanges.emplace_back(0, backingFile.size());
         }
     }
 
@@ -73,8 +73,8 @@ namespace UnityAsset {
 
         m_newStream.reset();
 
-        if(m_backingFile.data().length() != 0) {
-            m_unconsumedRanges.emplace_back(0, m_backingFile.data().length());
+        if(m_backingFile.size() != 0) {
+            m_unconsumedRanges.emplace_back(0, m_backingFile.size());
         }
 
         return true;
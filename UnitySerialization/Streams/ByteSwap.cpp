@@ -0,0 +1,128 @@
+#include <UnityAsset/Streams/ByteSwap.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UNITY_ASSET_BYTE_SWAP_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace UnityAsset {
+
+    template<typename T>
+    static void byteSwapScalar(unsigned char *data, size_t count) {
+        for(size_t index = 0; index < count; index++) {
+            T value;
+            memcpy(&value, data + index * sizeof(T), sizeof(T));
+            value = byteSwap(value);
+            memcpy(data + index * sizeof(T), &value, sizeof(T));
+        }
+    }
+
+    /*
+     * Swaps whole 16-byte vectors, and returns the number of the elements
+     * that were processed.
+     */
+    template<size_t ElementSize>
+    static size_t byteSwapVectors(unsigned char *data, size_t count) {
+        constexpr size_t ElementsPerVector = 16 / ElementSize;
+
+        size_t vectors = count / ElementsPerVector;
+
+#if defined(__SSSE3__)
+        __m128i shuffle;
+        if constexpr(ElementSize == 2) {
+            shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        } else if constexpr(ElementSize == 4) {
+            shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        } else {
+            shuffle = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        }
+
+        for(size_t index = 0; index < vectors; index++) {
+            auto pointer = reinterpret_cast<__m128i *>(data + index * 16);
+            _mm_storeu_si128(pointer, _mm_shuffle_epi8(_mm_loadu_si128(pointer), shuffle));
+        }
+
+#elif defined(UNITY_ASSET_BYTE_SWAP_SSE2)
+        for(size_t index = 0; index < vectors; index++) {
+            auto pointer = reinterpret_cast<__m128i *>(data + index * 16);
+            auto value = _mm_loadu_si128(pointer);
+
+            /*
+             * Without a byte shuffle, the larger elements are reversed by
+             * first reordering their 16-bit words, and then swapping the
+             * bytes within every word.
+             */
+            if constexpr(ElementSize == 4) {
+                value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+                value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+            } else if constexpr(ElementSize == 8) {
+                value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+                value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+            }
+
+            value = _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+
+            _mm_storeu_si128(pointer, value);
+        }
+
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+        for(size_t index = 0; index < vectors; index++) {
+            auto pointer = data + index * 16;
+            auto value = vld1q_u8(pointer);
+
+            if constexpr(ElementSize == 2) {
+                value = vrev16q_u8(value);
+            } else if constexpr(ElementSize == 4) {
+                value = vrev32q_u8(value);
+            } else {
+                value = vrev64q_u8(value);
+            }
+
+            vst1q_u8(pointer, value);
+        }
+
+#else
+        vectors = 0;
+#endif
+
+        return vectors * ElementsPerVector;
+    }
+
+    template<typename T>
+    static void byteSwapArrayOf(unsigned char *data, size_t count) {
+        auto processed = byteSwapVectors<sizeof(T)>(data, count);
+
+        byteSwapScalar<T>(data + processed * sizeof(T), count - processed);
+    }
+
+    void byteSwapArray(void *data, size_t count, size_t elementSize) {
+        auto bytes = static_cast<unsigned char *>(data);
+
+        switch(elementSize) {
+            case 1:
+                break;
+
+            case 2:
+                byteSwapArrayOf<uint16_t>(bytes, count);
+                break;
+
+            case 4:
+                byteSwapArrayOf<uint32_t>(bytes, count);
+                break;
+
+            case 8:
+                byteSwapArrayOf<uint64_t>(bytes, count);
+                break;
+
+            default:
+                throw std::logic_error("byteSwapArray: unsupported element size");
+        }
+    }
+}
@@ -0,0 +1,613 @@
+#include <UnityAsset/Streams/FileBatchReader.h>
+#include <UnityAsset/Streams/FileInputOutput.h>
+#include <UnityAsset/Streams/InMemoryStreamBackingBuffer.h>
+#include <UnityAsset/Streams/MappedFileStreamBackingBuffer.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#if defined(__linux__)
+#include <UnityAsset/FileDescriptor.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace UnityAsset {
+
+    class FileBatchReader::Backend {
+    public:
+        Backend() = default;
+        virtual ~Backend() = default;
+
+        Backend(const Backend &other) = delete;
+        Backend &operator =(const Backend &other) = delete;
+
+        virtual std::optional<Result> next() = 0;
+    };
+
+    /*
+     * Reads the files with readFile on a set of worker threads. The workers
+     * stop reading ahead once maximumInFlight files are waiting to be
+     * returned.
+     */
+    class FileBatchReader::ThreadPoolBackend final : public Backend {
+    public:
+        ThreadPoolBackend(std::vector<std::filesystem::path> &&paths, unsigned int maximumInFlight, AccessPattern pattern);
+        ~ThreadPoolBackend() override;
+
+        std::optional<Result> next() override;
+
+    private:
+        static constexpr size_t MaximumThreads = 16;
+
+        void worker();
+
+        std::vector<std::filesystem::path> m_paths;
+        size_t m_maximumInFlight;
+        AccessPattern m_pattern;
+
+        std::mutex m_mutex;
+        std::condition_variable m_completed;
+        std::condition_variable m_consumed;
+        size_t m_nextToRead;
+        size_t m_returned;
+        bool m_stopping;
+        std::deque<Result> m_results;
+
+        std::vector<std::thread> m_threads;
+    };
+
+    FileBatchReader::ThreadPoolBackend::ThreadPoolBackend(std::vector<std::filesystem::path> &&paths, unsigned int maximumInFlight,
+                                                          AccessPattern pattern) :
+        m_paths(std::move(paths)), m_maximumInFlight(maximumInFlight), m_pattern(pattern), m_nextToRead(0), m_returned(0),
+        m_stopping(false) {
+
+        auto threads = std::min<size_t>({ m_paths.size(), m_maximumInFlight, MaximumThreads });
+
+        m_threads.reserve(threads);
+
+        try {
+            for(size_t index = 0; index < threads; index++) {
+                m_threads.emplace_back(&ThreadPoolBackend::worker, this);
+            }
+        } catch(...) {
+            {
+                std::unique_lock<std::mutex> locker(m_mutex);
+                m_stopping = true;
+            }
+
+            m_consumed.notify_all();
+
+            for(auto &thread: m_threads) {
+                thread.join();
+            }
+
+            throw;
+        }
+    }
+
+    FileBatchReader::ThreadPoolBackend::~ThreadPoolBackend() {
+        {
+            std::unique_lock<std::mutex> locker(m_mutex);
+            m_stopping = true;
+        }
+
+        m_consumed.notify_all();
+
+        for(auto &thread: m_threads) {
+            thread.join();
+        }
+    }
+
+    void FileBatchReader::ThreadPoolBackend::worker() {
+        std::unique_lock<std::mutex> locker(m_mutex);
+
+        while(true) {
+            m_consumed.wait(locker, [this]() {
+                return m_stopping || m_nextToRead == m_paths.size() || m_nextToRead - m_returned < m_maximumInFlight;
+            });
+
+            if(m_stopping || m_nextToRead == m_paths.size())
+                break;
+
+            Result result;
+            result.index = m_nextToRead++;
+
+            locker.unlock();
+
+            try {
+                result.stream = Stream(readFile(m_paths[result.index], 0, std::string::npos, m_pattern));
+            } catch(...) {
+                result.error = std::current_exception();
+            }
+
+            locker.lock();
+
+            m_results.emplace_back(std::move(result));
+
+            m_completed.notify_one();
+        }
+    }
+
+    std::optional<FileBatchReader::Result> FileBatchReader::ThreadPoolBackend::next() {
+        std::unique_lock<std::mutex> locker(m_mutex);
+
+        if(m_returned == m_paths.size())
+            return std::nullopt;
+
+        m_completed.wait(locker, [this]() { return !m_results.empty(); });
+
+        auto result = std::move(m_results.front());
+        m_results.pop_front();
+        m_returned++;
+
+        m_consumed.notify_one();
+
+        return result;
+    }
+
+#if defined(__linux__)
+    /*
+     * Carries out the reads through io_uring, on the thread calling next().
+     * Each file takes up a slot while it's being read, and goes through an
+     * open, a statx on the opened file and, if it's small enough to be
+     * read into memory, one or more reads. Files large enough are mapped
+     * once their size is known.
+     *
+     * Only one request is outstanding per slot at any time, so the
+     * submission queue can never overflow.
+     */
+    class FileBatchReader::UringBackend final : public Backend {
+    public:
+        UringBackend(std::vector<std::filesystem::path> &paths, unsigned int maximumInFlight, AccessPattern pattern);
+        ~UringBackend() override;
+
+        std::optional<Result> next() override;
+
+    private:
+        struct Slot {
+            enum class State {
+                Free,
+                Opening,
+                Stating,
+                Reading
+            };
+
+            State state = State::Free;
+            size_t index = 0;
+            FileDescriptor file;
+            struct statx status;
+            std::vector<unsigned char> data;
+            size_t bytesRead = 0;
+        };
+
+        static bool isSupported(int ring);
+
+        struct io_uring_sqe *queueRequest(unsigned char opcode, size_t slot);
+        void queueOpen(size_t slot);
+        void queueStatus(size_t slot);
+        void queueRead(size_t slot);
+
+        void startFiles();
+        void submit(unsigned int minimumCompletions);
+        void reapCompletions();
+        void handleCompletion(size_t slot, int result);
+        void completeFile(size_t slot, Stream &&stream, std::exception_ptr error);
+        void releaseSlot(size_t slot);
+
+        FileDescriptor m_ring;
+
+        void *m_submissionRing;
+        size_t m_submissionRingSize;
+        void *m_completionRing;
+        size_t m_completionRingSize;
+        struct io_uring_sqe *m_submissionEntries;
+        size_t m_submissionEntriesSize;
+
+        unsigned int *m_submissionTail;
+        unsigned int m_submissionMask;
+        unsigned int *m_completionHead;
+        unsigned int *m_completionTail;
+        unsigned int m_completionMask;
+        struct io_uring_cqe *m_completionEntries;
+
+        unsigned int m_localSubmissionTail;
+        unsigned int m_unsubmitted;
+        size_t m_pendingRequests;
+        bool m_draining;
+
+        std::vector<std::filesystem::path> m_paths;
+        AccessPattern m_pattern;
+        size_t m_nextToStart;
+        std::vector<Slot> m_slots;
+        std::vector<size_t> m_freeSlots;
+        std::deque<Result> m_completed;
+    };
+
+    static int enterRing(int ring, unsigned int toSubmit, unsigned int minimumCompletions, unsigned int flags) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit, minimumCompletions, flags, nullptr, 0));
+    }
+
+    FileBatchReader::UringBackend::UringBackend(std::vector<std::filesystem::path> &paths, unsigned int maximumInFlight,
+                                                AccessPattern pattern) :
+        m_submissionRing(MAP_FAILED), m_submissionRingSize(0), m_completionRing(MAP_FAILED), m_completionRingSize(0),
+        m_submissionEntries(static_cast<struct io_uring_sqe *>(MAP_FAILED)), m_submissionEntriesSize(0),
+        m_localSubmissionTail(0), m_unsubmitted(0), m_pendingRequests(0), m_draining(false), m_pattern(pattern),
+        m_nextToStart(0) {
+
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        auto ring = static_cast<int>(syscall(__NR_io_uring_setup, maximumInFlight, &params));
+        if(ring < 0)
+            throw std::system_error(errno, std::generic_category());
+
+        m_ring = FileDescriptor(ring);
+
+        if(!isSupported(m_ring))
+            throw std::runtime_error("io_uring doesn't support the required operations");
+
+        m_submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+        m_completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+        if(params.features & IORING_FEAT_SINGLE_MMAP) {
+            m_submissionRingSize = std::max(m_submissionRingSize, m_completionRingSize);
+            m_completionRingSize = 0;
+        }
+
+        /*
+         * Whatever was mapped by this point is unmapped by the destructor,
+         * which isn't run if the constructor throws.
+         */
+        auto unmap = [this]() {
+            if(m_submissionEntries != MAP_FAILED)
+                munmap(m_submissionEntries, m_submissionEntriesSize);
+
+            if(m_completionRing != MAP_FAILED && m_completionRing != m_submissionRing)
+                munmap(m_completionRing, m_completionRingSize);
+
+            if(m_submissionRing != MAP_FAILED)
+                munmap(m_submissionRing, m_submissionRingSize);
+        };
+
+        m_submissionRing = mmap(nullptr, m_submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring,
+                                IORING_OFF_SQ_RING);
+        if(m_submissionRing == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category());
+
+        if(m_completionRingSize == 0) {
+            m_completionRing = m_submissionRing;
+        } else {
+            m_completionRing = mmap(nullptr, m_completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring,
+                                    IORING_OFF_CQ_RING);
+            if(m_completionRing == MAP_FAILED) {
+                auto error = errno;
+                unmap();
+                throw std::system_error(error, std::generic_category());
+            }
+        }
+
+        m_submissionEntriesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        m_submissionEntries = static_cast<struct io_uring_sqe *>(
+            mmap(nullptr, m_submissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES));
+        if(m_submissionEntries == MAP_FAILED) {
+            auto error = errno;
+            unmap();
+            throw std::system_error(error, std::generic_category());
+        }
+
+        auto submissionRing = static_cast<unsigned char *>(m_submissionRing);
+        auto completionRing = static_cast<unsigned char *>(m_completionRing);
+
+        m_submissionTail = reinterpret_cast<unsigned int *>(submissionRing + params.sq_off.tail);
+        m_submissionMask = *reinterpret_cast<unsigned int *>(submissionRing + params.sq_off.ring_mask);
+        m_completionHead = reinterpret_cast<unsigned int *>(completionRing + params.cq_off.head);
+        m_completionTail = reinterpret_cast<unsigned int *>(completionRing + params.cq_off.tail);
+        m_completionMask = *reinterpret_cast<unsigned int *>(completionRing + params.cq_off.ring_mask);
+        m_completionEntries = reinterpret_cast<struct io_uring_cqe *>(completionRing + params.cq_off.cqes);
+
+        /*
+         * Submission entries are always used in the order of the ring, so
+         * the indirection array is set up once as the identity.
+         */
+        auto array = reinterpret_cast<unsigned int *>(submissionRing + params.sq_off.array);
+        for(unsigned int index = 0; index < params.sq_entries; index++) {
+            array[index] = index;
+        }
+
+        m_localSubmissionTail = *m_submissionTail;
+
+        try {
+            m_slots.resize(std::min<size_t>(maximumInFlight, params.sq_entries));
+            m_freeSlots.reserve(m_slots.size());
+        } catch(...) {
+            unmap();
+            throw;
+        }
+
+        for(size_t slot = m_slots.size(); slot > 0; slot--) {
+            m_freeSlots.emplace_back(slot - 1);
+        }
+
+        m_paths = std::move(paths);
+    }
+
+    FileBatchReader::UringBackend::~UringBackend() {
+        /*
+         * The kernel may still write into the slots, so the outstanding
+         * requests have to finish before they're freed.
+         */
+        m_draining = true;
+
+        while(m_pendingRequests != 0) {
+            __atomic_store_n(m_submissionTail, m_localSubmissionTail, __ATOMIC_RELEASE);
+
+            auto result = enterRing(m_ring, m_unsubmitted, 1, IORING_ENTER_GETEVENTS);
+            if(result < 0) {
+                if(errno == EINTR)
+                    continue;
+
+                break;
+            }
+
+            m_unsubmitted -= result;
+
+            reapCompletions();
+        }
+
+        munmap(m_submissionEntries, m_submissionEntriesSize);
+
+        if(m_completionRing != m_submissionRing)
+            munmap(m_completionRing, m_completionRingSize);
+
+        munmap(m_submissionRing, m_submissionRingSize);
+    }
+
+    bool FileBatchReader::UringBackend::isSupported(int ring) {
+        std::vector<unsigned char> storage(sizeof(struct io_uring_probe) + IORING_OP_LAST * sizeof(struct io_uring_probe_op));
+        auto probe = reinterpret_cast<struct io_uring_probe *>(storage.data());
+
+        if(syscall(__NR_io_uring_register, ring, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) < 0)
+            return false;
+
+        for(auto opcode: { IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ }) {
+            if(opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED))
+                return false;
+        }
+
+        return true;
+    }
+
+    struct io_uring_sqe *FileBatchReader::UringBackend::queueRequest(unsigned char opcode, size_t slot) {
+        auto entry = &m_submissionEntries[m_localSubmissionTail & m_submissionMask];
+        memset(entry, 0, sizeof(*entry));
+
+        entry->opcode = opcode;
+        entry->user_data = slot;
+
+        m_localSubmissionTail++;
+        m_unsubmitted++;
+        m_pendingRequests++;
+
+        return entry;
+    }
+
+    void FileBatchReader::UringBackend::queueOpen(size_t slot) {
+        auto entry = queueRequest(IORING_OP_OPENAT, slot);
+        entry->fd = AT_FDCWD;
+        entry->addr = reinterpret_cast<uintptr_t>(m_paths[m_slots[slot].index].c_str());
+        entry->open_flags = O_RDONLY | O_CLOEXEC;
+    }
+
+    void FileBatchReader::UringBackend::queueStatus(size_t slot) {
+        auto entry = queueRequest(IORING_OP_STATX, slot);
+        entry->fd = m_slots[slot].file;
+        entry->addr = reinterpret_cast<uintptr_t>("");
+        entry->len = STATX_SIZE;
+        entry->statx_flags = AT_EMPTY_PATH;
+        entry->addr2 = reinterpret_cast<uintptr_t>(&m_slots[slot].status);
+    }
+
+    void FileBatchReader::UringBackend::queueRead(size_t slot) {
+        auto &data = m_slots[slot];
+
+        auto entry = queueRequest(IORING_OP_READ, slot);
+        entry->fd = data.file;
+        entry->addr = reinterpret_cast<uintptr_t>(data.data.data() + data.bytesRead);
+        entry->len = static_cast<uint32_t>(data.data.size() - data.bytesRead);
+        entry->off = data.bytesRead;
+    }
+
+    void FileBatchReader::UringBackend::startFiles() {
+        while(!m_freeSlots.empty() && m_nextToStart < m_paths.size()) {
+            auto slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+
+            m_slots[slot].state = Slot::State::Opening;
+            m_slots[slot].index = m_nextToStart++;
+
+            queueOpen(slot);
+        }
+    }
+
+    void FileBatchReader::UringBackend::submit(unsigned int minimumCompletions) {
+        if(m_unsubmitted == 0 && minimumCompletions == 0)
+            return;
+
+        __atomic_store_n(m_submissionTail, m_localSubmissionTail, __ATOMIC_RELEASE);
+
+        int result;
+
+        do {
+            result = enterRing(m_ring, m_unsubmitted, minimumCompletions, minimumCompletions != 0 ? IORING_ENTER_GETEVENTS : 0);
+        } while(result < 0 && errno == EINTR);
+
+        if(result < 0)
+            throw std::system_error(errno, std::generic_category());
+
+        m_unsubmitted -= result;
+    }
+
+    void FileBatchReader::UringBackend::reapCompletions() {
+        auto head = *m_completionHead;
+        auto tail = __atomic_load_n(m_completionTail, __ATOMIC_ACQUIRE);
+
+        while(head != tail) {
+            const auto &entry = m_completionEntries[head & m_completionMask];
+            auto slot = static_cast<size_t>(entry.user_data);
+            auto result = entry.res;
+
+            head++;
+
+            handleCompletion(slot, result);
+        }
+
+        __atomic_store_n(m_completionHead, head, __ATOMIC_RELEASE);
+    }
+
+    void FileBatchReader::UringBackend::handleCompletion(size_t slot, int result) {
+        auto &data = m_slots[slot];
+
+        m_pendingRequests--;
+
+        if(data.state == Slot::State::Opening && result >= 0)
+            data.file = FileDescriptor(result);
+
+        if(m_draining) {
+            releaseSlot(slot);
+            return;
+        }
+
+        if(result < 0) {
+            completeFile(slot, Stream(), std::make_exception_ptr(std::system_error(-result, std::generic_category())));
+            return;
+        }
+
+        try {
+            switch(data.state) {
+            case Slot::State::Opening:
+                data.state = Slot::State::Stating;
+                queueStatus(slot);
+                break;
+
+            case Slot::State::Stating:
+            {
+                auto size = static_cast<size_t>(data.status.stx_size);
+
+                if(size >= FileMappingThreshold) {
+                    completeFile(slot, Stream(std::make_shared<MappedFileStreamBackingBuffer>(data.file, 0, size, m_pattern)),
+                                 nullptr);
+                } else if(size == 0) {
+                    completeFile(slot, Stream(std::make_shared<InMemoryStreamBackingBuffer>()), nullptr);
+                } else {
+                    data.state = Slot::State::Reading;
+                    data.data.resize(size);
+                    data.bytesRead = 0;
+                    queueRead(slot);
+                }
+
+                break;
+            }
+
+            case Slot::State::Reading:
+                if(result == 0)
+                    throw std::runtime_error("the file was truncated while it was being read");
+
+                data.bytesRead += result;
+
+                if(data.bytesRead < data.data.size()) {
+                    queueRead(slot);
+                } else {
+                    completeFile(slot, Stream(std::make_shared<InMemoryStreamBackingBuffer>(std::move(data.data))), nullptr);
+                }
+
+                break;
+
+            case Slot::State::Free:
+                throw std::logic_error("FileBatchReader: completion for a free slot");
+            }
+        } catch(...) {
+            completeFile(slot, Stream(), std::current_exception());
+        }
+    }
+
+    void FileBatchReader::UringBackend::completeFile(size_t slot, Stream &&stream, std::exception_ptr error) {
+        m_completed.emplace_back(Result{ m_slots[slot].index, std::move(stream), std::move(error) });
+
+        releaseSlot(slot);
+    }
+
+    void FileBatchReader::UringBackend::releaseSlot(size_t slot) {
+        auto &data = m_slots[slot];
+
+        data.state = Slot::State::Free;
+        data.file.reset();
+        data.data = std::vector<unsigned char>();
+
+        m_freeSlots.emplace_back(slot);
+    }
+
+    std::optional<FileBatchReader::Result> FileBatchReader::UringBackend::next() {
+        while(m_completed.empty()) {
+            if(m_pendingRequests == 0 && m_nextToStart == m_paths.size())
+                return std::nullopt;
+
+            startFiles();
+            submit(1);
+            reapCompletions();
+        }
+
+        /*
+         * Get the requests for the following files going before returning,
+         * so they proceed while the caller processes this one.
+         */
+        startFiles();
+        submit(0);
+
+        auto result = std::move(m_completed.front());
+        m_completed.pop_front();
+
+        return result;
+    }
+#endif
+
+    FileBatchReader::FileBatchReader(std::vector<std::filesystem::path> paths, unsigned int maximumInFlight, AccessPattern pattern) {
+        maximumInFlight = std::max(1U, maximumInFlight);
+
+#if defined(__linux__)
+        try {
+            m_backend = std::make_unique<UringBackend>(paths, maximumInFlight, pattern);
+        } catch(const std::exception &) {
+            /*
+             * io_uring is unavailable or disabled; fall back to the threads.
+             */
+        }
+#endif
+
+        if(!m_backend)
+            m_backend = std::make_unique<ThreadPoolBackend>(std::move(paths), maximumInFlight, pattern);
+    }
+
+    FileBatchReader::~FileBatchReader() = default;
+
+    FileBatchReader::FileBatchReader(FileBatchReader &&other) noexcept = default;
+
+    FileBatchReader &FileBatchReader::operator =(FileBatchReader &&other) noexcept = default;
+
+    std::optional<FileBatchReader::Result> FileBatchReader::next() {
+        return m_backend->next();
+    }
+}
@@ -1,10 +1,12 @@
 #include <UnityAsset/Streams/FileInputOutput.h>
 #include <UnityAsset/Streams/InMemoryStreamBackingBuffer.h>
 #include <UnityAsset/Streams/MappedFileStreamBackingBuffer.h>
+#include <UnityAsset/Streams/MappedOutputFileStreamBackingBuffer.h>
 #include <UnityAsset/Streams/Stream.h>
 
 #include <UnityAsset/FileDescriptor.h>
 
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 #include <system_error>
@@ -15,7 +17,10 @@
 #include <UnityAsset/WindowsError.h>
 #else
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
 #endif
 
 namespace UnityAsset {
@@ -52,10 +57,66 @@ namespace UnityAsset {
             throw std::logic_error("short read");
     }
 
+    void writeFile(
+        const UnityAsset::WindowsHandle& fd,
+        const unsigned char* ptr,
+        size_t offset,
+        size_t size
+    ) {
+        while (size > 0) {
+            OVERLAPPED overlapped;
+            ZeroMemory(&overlapped, sizeof(overlapped));
+
+            overlapped.Offset = static_cast<DWORD>(offset);
+            if constexpr (sizeof(offset) > 4) {
+                overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            }
+            else {
+                overlapped.OffsetHigh = 0;
+            }
+
+            auto chunk = static_cast<DWORD>(std::min<size_t>(size, std::numeric_limits<DWORD>::max()));
+
+            DWORD bytesWritten;
+            auto result = WriteFile(fd, ptr, chunk, &bytesWritten, &overlapped);
+            if (!result)
+                WindowsError::throwLastError();
+
+            ptr += bytesWritten;
+            size -= bytesWritten;
+            offset += bytesWritten;
+        }
+    }
+
+    void writeFile(
+        const UnityAsset::WindowsHandle& fd,
+        const std::vector<FileSegment>& segments,
+        size_t offset
+    ) {
+        /*
+         * WriteFileGather only takes page-sized, page-aligned buffers, so
+         * the segments are written one by one.
+         */
+        for (const auto& segment : segments) {
+            writeFile(fd, segment.data, offset, segment.size);
+
+            offset += segment.size;
+        }
+    }
+
+    void truncateFile(const UnityAsset::WindowsHandle& fd, size_t size) {
+        FILE_END_OF_FILE_INFO info;
+        info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+
+        if (!SetFileInformationByHandle(fd, FileEndOfFileInfo, &info, sizeof(info)))
+            WindowsError::throwLastError();
+    }
+
     std::shared_ptr<StreamBackingBuffer> readFile(
         const UnityAsset::WindowsHandle & fd,
         size_t offset,
-        size_t size
+        size_t size,
+        AccessPattern pattern
     ) {
 
         LARGE_INTEGER fileSize;
@@ -73,7 +134,7 @@ namespace UnityAsset {
         else if (size + offset > fileSizeT)
             throw std::logic_error("readFile: size is out of range");
 
-        if (size < 65536) {
+        if (size < FileMappingThreshold) {
             std::vector<unsigned char> data(size);
 
             readFile(fd, data.data(), offset, data.size());
@@ -81,13 +142,14 @@ namespace UnityAsset {
             return std::make_shared<InMemoryStreamBackingBuffer>(std::move(data));
         }
 
-        return std::make_shared<MappedFileStreamBackingBuffer>(fd, offset, size);
+        return std::make_shared<MappedFileStreamBackingBuffer>(fd, offset, size, pattern);
     }
 
     std::shared_ptr<StreamBackingBuffer> readFile(
         const std::filesystem::path& path,
         size_t offset,
-        size_t size
+        size_t size,
+        AccessPattern pattern
     ) {
         auto rawHandle = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
         if (rawHandle == INVALID_HANDLE_VALUE)
@@ -95,7 +157,15 @@ namespace UnityAsset {
 
         UnityAsset::WindowsHandle handle(rawHandle);
 
-        return readFile(handle, offset, size);
+        return readFile(handle, offset, size, pattern);
+    }
+
+    std::shared_ptr<MappedOutputFileStreamBackingBuffer> createOutputFile(const std::filesystem::path &path) {
+        auto rawHandle = CreateFile(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (rawHandle == INVALID_HANDLE_VALUE)
+            WindowsError::throwLastError();
+
+        return std::make_shared<MappedOutputFileStreamBackingBuffer>(UnityAsset::WindowsHandle(rawHandle));
     }
 
 #else
@@ -121,11 +191,99 @@ namespace UnityAsset {
         }
     }
 
-    std::shared_ptr<StreamBackingBuffer> readFile(
+    void writeFile(
         const UnityAsset::FileDescriptor &fd,
+        const unsigned char *ptr,
         size_t offset,
         size_t size
     ) {
+        while(size > 0) {
+            ssize_t result;
+
+            do {
+                result = pwrite(fd, ptr, size, offset);
+            } while(result == -1 && errno == EINTR);
+
+            if(result < 0)
+                throw std::system_error(errno, std::generic_category());
+
+            ptr += result;
+            size -= result;
+            offset += result;
+        }
+    }
+
+    void writeFile(
+        const UnityAsset::FileDescriptor &fd,
+        const std::vector<FileSegment> &segments,
+        size_t offset
+    ) {
+        std::vector<struct iovec> vectors;
+        vectors.reserve(std::min<size_t>(segments.size(), IOV_MAX));
+
+        auto segment = segments.begin();
+        size_t segmentOffset = 0;
+
+        while(segment != segments.end()) {
+            vectors.clear();
+
+            for(auto next = segment; next != segments.end() && vectors.size() < IOV_MAX; ++next) {
+                auto skip = (next == segment) ? segmentOffset : 0;
+
+                if(next->size != skip) {
+                    vectors.emplace_back(iovec{
+                        .iov_base = const_cast<unsigned char *>(next->data + skip),
+                        .iov_len = next->size - skip
+                    });
+                }
+            }
+
+            ssize_t result = 0;
+
+            if(!vectors.empty()) {
+                do {
+                    result = pwritev(fd, vectors.data(), static_cast<int>(vectors.size()), offset);
+                } while(result == -1 && errno == EINTR);
+
+                if(result < 0)
+                    throw std::system_error(errno, std::generic_category());
+            }
+
+            offset += result;
+
+            /*
+             * Advance past what was written, which may end in the middle of
+             * a segment.
+             */
+            auto remaining = static_cast<size_t>(result);
+
+            while(segment != segments.end() && remaining >= segment->size - segmentOffset) {
+                remaining -= segment->size - segmentOffset;
+                segmentOffset = 0;
+                ++segment;
+            }
+
+            segmentOffset += remaining;
+        }
+    }
+
+    void truncateFile(const UnityAsset::FileDescriptor &fd, size_t size) {
+        int result;
+
+        do {
+            result = ftruncate(fd, static_cast<off_t>(size));
+        } while(result == -1 && errno == EINTR);
+
+        if(result < 0)
+            throw std::system_error(errno, std::generic_category());
+    }
+
+    std::shared_ptr<StreamBackingBuffer> readFile(
+        const UnityAsset::FileDescriptor &fd,
+        size_t offset,
+        size_t size,
+        AccessPattern pattern
+    ) {
 
         struct stat st;
         if(fstat(fd, &st) < 0)
@@ -139,7 +297,7 @@ namespace UnityAsset {
         else if(static_cast<off_t>(size + offset) > st.st_size)
             throw std::logic_error("readFile: size is out of range");
 
-        if(size < 65536) {
+        if(size < FileMappingThreshold) {
             std::vector<unsigned char> data(size);
 
             readFile(fd, data.data(), offset, data.size());
@@ -147,13 +305,14 @@ namespace UnityAsset {
             return std::make_shared<InMemoryStreamBackingBuffer>(std::move(data));
         }
 
-        return std::make_shared<MappedFileStreamBackingBuffer>(fd, offset, size);
+        return std::make_shared<MappedFileStreamBackingBuffer>(fd, offset, size, pattern);
     }
 
     std::shared_ptr<StreamBackingBuffer> readFile(
         const std::filesystem::path &path,
         size_t offset,
-        size_t size
+        size_t size,
+        AccessPattern pattern
     ) {
         int rawfd = open(path.c_str(), O_RDONLY);
         if(rawfd < 0)
@@ -161,7 +320,15 @@ namespace UnityAsset {
 
         UnityAsset::FileDescriptor fd(rawfd);
 
-        return readFile(fd, offset, size);
+        return readFile(fd, offset, size, pattern);
+    }
+
+    std::shared_ptr<MappedOutputFileStreamBackingBuffer> createOutputFile(const std::filesystem::path &path) {
+        int rawfd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+        if(rawfd < 0)
+            throw std::system_error(errno, std::generic_category());
+
+        return std::make_shared<MappedOutputFileStreamBackingBuffer>(UnityAsset::FileDescriptor(rawfd));
     }
 #endif
 
@@ -1,24 +1,68 @@
- #include <UnityAsset/Streams/InMemoryStreamBackingBuffer.h>
+#include <UnityAsset/Streams/InMemoryStreamBackingBuffer.h>
+
+#include <algorithm>
+#include <cstring>
 
 namespace UnityAsset {
-    InMemoryStreamBackingBuffer::InMemoryStreamBackingBuffer() = default;
+    InMemoryStreamBackingBuffer::InMemoryStreamBackingBuffer() : m_data(nullptr), m_size(0), m_capacity(0) {
+
+    }
 
-    InMemoryStreamBackingBuffer::InMemoryStreamBackingBuffer(std::vector<unsigned char> &&data) : m_data(std::move(data)) {
+    InMemoryStreamBackingBuffer::InMemoryStreamBackingBuffer(std::vector<unsigned char> &&data) : m_initialData(std::move(data)),
+        m_data(m_initialData.data()), m_size(m_initialData.size()), m_capacity(m_initialData.size()) {
+
+    }
+
+    InMemoryStreamBackingBuffer::InMemoryStreamBackingBuffer(size_t size) : m_storage(std::make_unique_for_overwrite<unsigned char[]>(size)),
+        m_data(m_storage.get()), m_size(size), m_capacity(size) {
 
     }
 
     InMemoryStreamBackingBuffer::~InMemoryStreamBackingBuffer() = default;
 
     void InMemoryStreamBackingBuffer::resize(size_t size) {
-        m_data.resize(size);
+        auto previousSize = m_size;
+
+        resizeForOverwrite(size);
+
+        if(size > previousSize) {
+            memset(m_data + previousSize, 0, size - previousSize);
+        }
+    }
+
+    void InMemoryStreamBackingBuffer::resizeForOverwrite(size_t size) {
+        if(size > m_capacity) {
+            grow(std::max({ size, m_capacity + m_capacity / 2, MinimumGrowthCapacity }));
+        }
+
+        m_size = size;
+    }
+
+    void InMemoryStreamBackingBuffer::reserve(size_t capacity) {
+        if(capacity > m_capacity) {
+            grow(capacity);
+        }
+    }
+
+    void InMemoryStreamBackingBuffer::grow(size_t capacity) {
+        auto storage = std::make_unique_for_overwrite<unsigned char[]>(capacity);
+
+        if(m_size != 0) {
+            memcpy(storage.get(), m_data, m_size);
+        }
+
+        m_storage = std::move(storage);
+        m_initialData = std::vector<unsigned char>();
+        m_data = m_storage.get();
+        m_capacity = capacity;
     }
 
     const unsigned char *InMemoryStreamBackingBuffer::data() const {
-        return m_data.data();
+        return m_data;
     }
 
     size_t InMemoryStreamBackingBuffer::size() const {
-        return m_data.size();
+        return m_size;
     }
 
 }
@@ -6,6 +6,8 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
 #include <system_error>
 
@@ -13,7 +15,8 @@ namespace UnityAsset {
     const unsigned long MappedFileStreamBackingBuffer::m_pageSize = queryPageSize();
 
 #if defined(_WIN32)
-    MappedFileStreamBackingBuffer::MappedFileStreamBackingBuffer(const WindowsHandle& fd, uint64_t offset, size_t size) {
+    MappedFileStreamBackingBuffer::MappedFileStreamBackingBuffer(const WindowsHandle& fd, uint64_t offset, size_t size,
+                                                                 AccessPattern pattern) {
         if (size == 0) {
             m_data = nullptr;
             m_dataForAccess = nullptr;
@@ -46,6 +49,9 @@ namespace UnityAsset {
                 WindowsError::throwLastError();
 
             m_dataForAccess = static_cast<unsigned char*>(m_data) + extraSize;
+
+            if (pattern != AccessPattern::Normal)
+                adviseAccessPattern(0, m_sizeForAccess, pattern);
         }
 
     }
@@ -56,6 +62,28 @@ namespace UnityAsset {
         }
     }
 
+    void MappedFileStreamBackingBuffer::adviseAccessPattern(size_t offset, size_t size, AccessPattern pattern) {
+        /*
+         * Windows only has the prefetch part.
+         */
+        if (pattern == AccessPattern::Preload)
+            prefetch(offset, size);
+    }
+
+    void MappedFileStreamBackingBuffer::prefetch(size_t offset, size_t size) {
+        if (offset >= m_sizeForAccess)
+            return;
+
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<unsigned char*>(m_dataForAccess) + offset;
+        range.NumberOfBytes = std::min(size, m_sizeForAccess - offset);
+
+        /*
+         * This is only a hint, so the failures are ignored.
+         */
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+
     unsigned long MappedFileStreamBackingBuffer::queryPageSize() {
         SYSTEM_INFO info;
         GetSystemInfo(&info);
@@ -64,7 +92,7 @@ namespace UnityAsset {
     }
 
 #else
-    MappedFileStreamBackingBuffer::MappedFileStreamBackingBuffer(int fd, off_t offset, size_t size) {
+    MappedFileStreamBackingBuffer::MappedFileStreamBackingBuffer(int fd, off_t offset, size_t size, AccessPattern pattern) {
         if(size == 0) {
             m_data = nullptr;
             m_size = 0;
@@ -77,12 +105,25 @@ namespace UnityAsset {
             auto extraSize = offset - adjustedOffset;
             size += extraSize;
 
+            int flags = MAP_PRIVATE;
+            bool populated = false;
+
+#if defined(MAP_POPULATE)
+            if(pattern == AccessPattern::Preload) {
+                flags |= MAP_POPULATE;
+                populated = true;
+            }
+#endif
+
             m_size = size;
-            m_data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, adjustedOffset);
+            m_data = mmap(nullptr, size, PROT_READ, flags, fd, adjustedOffset);
             if(m_data == MAP_FAILED)
                 throw std::system_error(errno, std::generic_category());
 
             m_dataForAccess = static_cast<unsigned char *>(m_data) + extraSize;
+
+            if(pattern != AccessPattern::Normal && !populated)
+                adviseAccessPattern(0, m_sizeForAccess, pattern);
         }
     }
 
@@ -92,6 +133,53 @@ namespace UnityAsset {
         }
     }
 
+    /*
+     * madvise wants a page-aligned address, so the range is extended down to
+     * the page boundary, but it's never extended beyond the mapping.
+     */
+    static void adviseRange(const unsigned char *data, size_t dataSize, size_t offset, size_t size, unsigned long pageSize, int advice) {
+        if(offset >= dataSize)
+            return;
+
+        size = std::min(size, dataSize - offset);
+
+        auto address = reinterpret_cast<uintptr_t>(data + offset);
+        auto alignedAddress = address & ~static_cast<uintptr_t>(pageSize - 1);
+
+        /*
+         * This is only a hint, so the failures are ignored.
+         */
+        (void)madvise(reinterpret_cast<void *>(alignedAddress), size + (address - alignedAddress), advice);
+    }
+
+    void MappedFileStreamBackingBuffer::adviseAccessPattern(size_t offset, size_t size, AccessPattern pattern) {
+        int advice;
+
+        switch(pattern) {
+            case AccessPattern::Sequential:
+                advice = MADV_SEQUENTIAL;
+                break;
+
+            case AccessPattern::Random:
+                advice = MADV_RANDOM;
+                break;
+
+            case AccessPattern::Preload:
+                advice = MADV_WILLNEED;
+                break;
+
+            default:
+                advice = MADV_NORMAL;
+                break;
+        }
+
+        adviseRange(m_dataForAccess, m_sizeForAccess, offset, size, m_pageSize, advice);
+    }
+
+    void MappedFileStreamBackingBuffer::prefetch(size_t offset, size_t size) {
+        adviseRange(m_dataForAccess, m_sizeForAccess, offset, size, m_pageSize, MADV_WILLNEED);
+    }
+
     unsigned long MappedFileStreamBackingBuffer::queryPageSize() {
         auto pageSize = sysconf(_SC_PAGESIZE);
         if (pageSize < 0)
@@ -0,0 +1,177 @@
+#include <UnityAsset/Streams/MappedOutputFileStreamBackingBuffer.h>
+
+#if defined(_WIN32)
+#include <UnityAsset/WindowsError.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+namespace UnityAsset {
+
+#if defined(_WIN32)
+    MappedOutputFileStreamBackingBuffer::MappedOutputFileStreamBackingBuffer(WindowsHandle &&file) : m_file(std::move(file)),
+#else
+    MappedOutputFileStreamBackingBuffer::MappedOutputFileStreamBackingBuffer(FileDescriptor &&file) : m_file(std::move(file)),
+#endif
+        m_data(nullptr), m_size(0), m_capacity(0), m_clean(0) {
+
+    }
+
+    MappedOutputFileStreamBackingBuffer::~MappedOutputFileStreamBackingBuffer() {
+        try {
+            close();
+        } catch(...) {
+
+        }
+    }
+
+    size_t MappedOutputFileStreamBackingBuffer::size() const {
+        return m_size;
+    }
+
+    void MappedOutputFileStreamBackingBuffer::resize(size_t size) {
+        auto previousSize = m_size;
+        auto dirtyEnd = std::min(size, m_clean);
+
+        resizeForOverwrite(size);
+
+        if(dirtyEnd > previousSize) {
+            memset(m_data + previousSize, 0, dirtyEnd - previousSize);
+        }
+    }
+
+    void MappedOutputFileStreamBackingBuffer::resizeForOverwrite(size_t size) {
+        if(!m_file)
+            throw std::logic_error("MappedOutputFileStreamBackingBuffer::resizeForOverwrite: the buffer is closed");
+
+        if(size > m_capacity) {
+            grow(std::max(size, m_capacity * 2));
+        }
+
+        m_size = size;
+        m_clean = std::max(m_clean, size);
+    }
+
+    void MappedOutputFileStreamBackingBuffer::reserve(size_t capacity) {
+        if(capacity > m_capacity) {
+            grow(capacity);
+        }
+    }
+
+    const unsigned char *MappedOutputFileStreamBackingBuffer::data() const {
+        return m_data;
+    }
+
+#if defined(_WIN32)
+    void MappedOutputFileStreamBackingBuffer::grow(size_t capacity) {
+        if(!m_file)
+            throw std::logic_error("MappedOutputFileStreamBackingBuffer::grow: the buffer is closed");
+
+        capacity = (capacity + GrowthGranularity - 1) & ~(GrowthGranularity - 1);
+
+        /*
+         * A file mapping can't be extended, so the view is recreated over a
+         * new, larger mapping, which also extends the file.
+         */
+        unmap();
+
+        auto capacity64 = static_cast<uint64_t>(capacity);
+
+        auto rawMapping = CreateFileMapping(m_file, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(capacity64 >> 32), static_cast<DWORD>(capacity64), nullptr);
+        if(!rawMapping)
+            WindowsError::throwLastError();
+
+        m_mapping = WindowsHandle(rawMapping);
+
+        auto data = MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, capacity);
+        if(data == nullptr)
+            WindowsError::throwLastError();
+
+        m_data = static_cast<unsigned char *>(data);
+        m_capacity = capacity;
+    }
+
+    void MappedOutputFileStreamBackingBuffer::unmap() noexcept {
+        if(m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+            m_data = nullptr;
+        }
+
+        m_mapping.reset();
+    }
+
+    void MappedOutputFileStreamBackingBuffer::close() {
+        if(!m_file)
+            return;
+
+        unmap();
+
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(m_size);
+
+        auto file = std::move(m_file);
+
+        if(!SetFilePointerEx(file, size, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+            WindowsError::throwLastError();
+    }
+
+#else
+    void MappedOutputFileStreamBackingBuffer::grow(size_t capacity) {
+        if(!m_file)
+            throw std::logic_error("MappedOutputFileStreamBackingBuffer::grow: the buffer is closed");
+
+        capacity = (capacity + GrowthGranularity - 1) & ~(GrowthGranularity - 1);
+
+        if(ftruncate(m_file, static_cast<off_t>(capacity)) < 0)
+            throw std::system_error(errno, std::generic_category());
+
+        void *data;
+
+#if defined(__linux__)
+        if(m_data != nullptr) {
+            data = mremap(m_data, m_capacity, capacity, MREMAP_MAYMOVE);
+        } else {
+            data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+        }
+
+        if(data == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category());
+#else
+        data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+        if(data == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category());
+
+        unmap();
+#endif
+
+        m_data = static_cast<unsigned char *>(data);
+        m_capacity = capacity;
+    }
+
+    void MappedOutputFileStreamBackingBuffer::unmap() noexcept {
+        if(m_data != nullptr) {
+            munmap(m_data, m_capacity);
+            m_data = nullptr;
+        }
+    }
+
+    void MappedOutputFileStreamBackingBuffer::close() {
+        if(!m_file)
+            return;
+
+        unmap();
+
+        auto file = std::move(m_file);
+
+        if(ftruncate(file, static_cast<off_t>(m_size)) < 0)
+            throw std::system_error(errno, std::generic_category());
+    }
+#endif
+}
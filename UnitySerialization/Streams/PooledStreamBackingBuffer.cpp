@@ -0,0 +1,59 @@
+#include <UnityAsset/Streams/PooledStreamBackingBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace UnityAsset {
+
+    PooledStreamBackingBuffer::PooledStreamBackingBuffer() : m_size(0) {
+
+    }
+
+    PooledStreamBackingBuffer::PooledStreamBackingBuffer(size_t size) : m_storage(size), m_size(size) {
+
+    }
+
+    PooledStreamBackingBuffer::~PooledStreamBackingBuffer() = default;
+
+    size_t PooledStreamBackingBuffer::size() const {
+        return m_size;
+    }
+
+    void PooledStreamBackingBuffer::resize(size_t size) {
+        auto previousSize = m_size;
+
+        resizeForOverwrite(size);
+
+        if(size > previousSize) {
+            memset(m_storage.data() + previousSize, 0, size - previousSize);
+        }
+    }
+
+    void PooledStreamBackingBuffer::resizeForOverwrite(size_t size) {
+        if(size > m_storage.capacity()) {
+            grow(std::max(size, m_storage.capacity() * 2));
+        }
+
+        m_size = size;
+    }
+
+    void PooledStreamBackingBuffer::reserve(size_t capacity) {
+        if(capacity > m_storage.capacity()) {
+            grow(capacity);
+        }
+    }
+
+    void PooledStreamBackingBuffer::grow(size_t capacity) {
+        ScratchBuffer storage(capacity);
+
+        if(m_size != 0) {
+            memcpy(storage.data(), m_storage.data(), m_size);
+        }
+
+        m_storage = std::move(storage);
+    }
+
+    const unsigned char *PooledStreamBackingBuffer::data() const {
+        return m_storage.data();
+    }
+}
@@ -0,0 +1,42 @@
+#include <UnityAsset/Streams/ScratchBuffer.h>
+#include <UnityAsset/Streams/ScratchBufferPool.h>
+
+namespace UnityAsset {
+
+    ScratchBuffer::ScratchBuffer() noexcept : m_capacity(0) {
+
+    }
+
+    ScratchBuffer::ScratchBuffer(size_t size) : m_capacity(ScratchBufferPool::storageCapacity(size)) {
+        m_storage = ScratchBufferPool::instance().allocate(m_capacity);
+    }
+
+    ScratchBuffer::~ScratchBuffer() {
+        reset();
+    }
+
+    ScratchBuffer::ScratchBuffer(ScratchBuffer &&other) noexcept : m_storage(std::move(other.m_storage)), m_capacity(other.m_capacity) {
+        other.m_capacity = 0;
+    }
+
+    ScratchBuffer &ScratchBuffer::operator =(ScratchBuffer &&other) noexcept {
+        if(this != &other) {
+            reset();
+
+            m_storage = std::move(other.m_storage);
+            m_capacity = other.m_capacity;
+            other.m_capacity = 0;
+        }
+
+        return *this;
+    }
+
+    void ScratchBuffer::reset() noexcept {
+        if(m_storage) {
+            ScratchBufferPool::instance().release(std::move(m_storage), m_capacity);
+            m_storage.reset();
+        }
+
+        m_capacity = 0;
+    }
+}
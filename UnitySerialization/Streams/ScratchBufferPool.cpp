@@ -0,0 +1,147 @@
+#include <UnityAsset/Streams/ScratchBufferPool.h>
+
+#include <array>
+#include <bit>
+#include <vector>
+
+namespace UnityAsset {
+
+    static constexpr size_t SizeClassCount =
+        std::countr_zero(ScratchBufferPool::MaximumPooledSize) - std::countr_zero(ScratchBufferPool::MinimumPooledSize) + 1;
+
+    /*
+     * The storage retained by a thread. The flag is kept separately, and is
+     * trivially destructible, so that it can still be checked when the
+     * buffers are released by thread-local objects destroyed after the
+     * storage of the thread.
+     */
+    struct ScratchBufferPool::ThreadStorage {
+        ~ThreadStorage();
+
+        void clear() noexcept;
+
+        std::array<std::vector<std::unique_ptr<unsigned char[]>>, SizeClassCount> freeStorage;
+        size_t retainedBytes = 0;
+    };
+
+    static thread_local bool threadStorageDestroyed = false;
+
+    static size_t sizeClassIndex(size_t capacity) {
+        return std::countr_zero(capacity) - std::countr_zero(ScratchBufferPool::MinimumPooledSize);
+    }
+
+    ScratchBufferPool::ThreadStorage::~ThreadStorage() {
+        clear();
+
+        threadStorageDestroyed = true;
+    }
+
+    void ScratchBufferPool::ThreadStorage::clear() noexcept {
+        for(auto &storage: freeStorage) {
+            storage.clear();
+        }
+
+        instance().m_retainedBytes -= retainedBytes;
+        retainedBytes = 0;
+    }
+
+    auto ScratchBufferPool::threadStorage() -> ThreadStorage * {
+        if(threadStorageDestroyed)
+            return nullptr;
+
+        static thread_local ThreadStorage storage;
+
+        return &storage;
+    }
+
+    ScratchBufferPool::ScratchBufferPool() : m_retainedBytesLimit(256 * 1024 * 1024), m_retainedBytes(0), m_hits(0), m_misses(0) {
+
+    }
+
+    ScratchBufferPool::~ScratchBufferPool() = default;
+
+    ScratchBufferPool &ScratchBufferPool::instance() {
+        /*
+         * Intentionally never destroyed: the buffers may be released by
+         * static destructors.
+         */
+        static auto pool = new ScratchBufferPool;
+
+        return *pool;
+    }
+
+    void ScratchBufferPool::setRetainedBytesLimit(size_t limit) {
+        m_retainedBytesLimit = limit;
+    }
+
+    size_t ScratchBufferPool::retainedBytesLimit() const {
+        return m_retainedBytesLimit;
+    }
+
+    void ScratchBufferPool::trim() {
+        auto storage = threadStorage();
+        if(storage)
+            storage->clear();
+    }
+
+    auto ScratchBufferPool::statistics() const -> Statistics {
+        return Statistics{
+            .hits = m_hits,
+            .misses = m_misses,
+            .retainedBytes = m_retainedBytes
+        };
+    }
+
+    void ScratchBufferPool::resetStatistics() {
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    size_t ScratchBufferPool::storageCapacity(size_t size) {
+        if(size < MinimumPooledSize || size > MaximumPooledSize)
+            return size;
+
+        return std::bit_ceil(size);
+    }
+
+    std::unique_ptr<unsigned char[]> ScratchBufferPool::allocate(size_t capacity) {
+        auto threadStorage = this->threadStorage();
+
+        if(capacity >= MinimumPooledSize && capacity <= MaximumPooledSize && threadStorage) {
+            auto &freeStorage = threadStorage->freeStorage[sizeClassIndex(capacity)];
+
+            if(!freeStorage.empty()) {
+                auto storage = std::move(freeStorage.back());
+                freeStorage.pop_back();
+
+                threadStorage->retainedBytes -= capacity;
+                m_retainedBytes -= capacity;
+                m_hits++;
+
+                return storage;
+            }
+
+            m_misses++;
+        }
+
+        return std::make_unique_for_overwrite<unsigned char[]>(capacity);
+    }
+
+    void ScratchBufferPool::release(std::unique_ptr<unsigned char[]> &&storage, size_t capacity) noexcept {
+        if(capacity < MinimumPooledSize || capacity > MaximumPooledSize)
+            return;
+
+        auto threadStorage = this->threadStorage();
+        if(!threadStorage || threadStorage->retainedBytes + capacity > m_retainedBytesLimit)
+            return;
+
+        try {
+            threadStorage->freeStorage[sizeClassIndex(capacity)].emplace_back(std::move(storage));
+        } catch(...) {
+            return;
+        }
+
+        threadStorage->retainedBytes += capacity;
+        m_retainedBytes += capacity;
+    }
+}
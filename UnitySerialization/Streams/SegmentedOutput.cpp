@@ -0,0 +1,88 @@
+#include <UnityAsset/Streams/SegmentedOutput.h>
+#include <UnityAsset/Streams/FileInputOutput.h>
+
+#if defined(_WIN32)
+#include <UnityAsset/WindowsHandle.h>
+#else
+#include <UnityAsset/FileDescriptor.h>
+#endif
+
+#include <algorithm>
+
+namespace UnityAsset {
+
+    static const unsigned char zeroBlock[64 * 1024] = {};
+
+    SegmentedOutput::SegmentedOutput() : m_length(0) {
+
+    }
+
+    SegmentedOutput::~SegmentedOutput() = default;
+
+    SegmentedOutput::SegmentedOutput(SegmentedOutput &&other) noexcept = default;
+
+    SegmentedOutput &SegmentedOutput::operator =(SegmentedOutput &&other) noexcept = default;
+
+    void SegmentedOutput::append(const Stream &data) {
+        if(data.length() == 0)
+            return;
+
+        m_segments.emplace_back(Segment{ .data = data.createView(), .zeroes = 0 });
+        m_length += data.length();
+    }
+
+    void SegmentedOutput::appendZeroes(size_t count) {
+        if(count == 0)
+            return;
+
+        if(m_segments.empty()) {
+            m_segments.emplace_back(Segment{ .data = std::nullopt, .zeroes = 0 });
+        }
+
+        m_segments.back().zeroes += count;
+        m_length += count;
+    }
+
+    void SegmentedOutput::writeTo(Stream &output) const {
+        output.reserve(output.position() + m_length);
+
+        for(const auto &segment: m_segments) {
+            if(segment.data.has_value()) {
+                output.writeData(segment.data->data(), segment.data->length());
+            }
+
+            for(size_t written = 0; written < segment.zeroes; ) {
+                auto piece = std::min(segment.zeroes - written, sizeof(zeroBlock));
+
+                output.writeData(zeroBlock, piece);
+
+                written += piece;
+            }
+        }
+    }
+
+#if defined(_WIN32)
+    void SegmentedOutput::writeTo(const WindowsHandle &output, size_t offset) const {
+#else
+    void SegmentedOutput::writeTo(const FileDescriptor &output, size_t offset) const {
+#endif
+        std::vector<FileSegment> fileSegments;
+        fileSegments.reserve(m_segments.size() * 2);
+
+        for(const auto &segment: m_segments) {
+            if(segment.data.has_value()) {
+                fileSegments.emplace_back(FileSegment{ .data = segment.data->data(), .size = segment.data->length() });
+            }
+
+            for(size_t written = 0; written < segment.zeroes; ) {
+                auto piece = std::min(segment.zeroes - written, sizeof(zeroBlock));
+
+                fileSegments.emplace_back(FileSegment{ .data = zeroBlock, .size = piece });
+
+                written += piece;
+            }
+        }
+
+        writeFile(output, fileSegments, offset);
+    }
+}
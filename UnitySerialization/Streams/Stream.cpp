@@ -1,7 +1,10 @@
 #include <UnityAsset/Streams/Stream.h>
 #include <UnityAsset/Streams/InMemoryStreamBackingBuffer.h>
+#include <UnityAsset/Streams/ByteSwap.h>
 
+#include <algorithm>
 #include <cstring>
+#include <stdexcept>
 
 namespace UnityAsset {
 
@@ -26,17 +29,48 @@ namespace UnityAsset {
             m_length = storageSize - offset;
         } else if(m_length + offset > storageSize)
             throw std::logic_error("Stream: size is out of range");
+
+        backingBuffer->acquire(m_offset, m_length);
     }
 
-    Stream::~Stream() = default;
+    Stream::~Stream() {
+        if(m_backingBuffer)
+            m_backingBuffer->release(m_offset, m_length);
+    }
 
-    Stream::Stream(const Stream &other) = default;
+    Stream::Stream(const Stream &other) : m_byteOrder(other.m_byteOrder), m_operationSet(other.m_operationSet),
+        m_backingBuffer(other.m_backingBuffer), m_offset(other.m_offset), m_length(other.m_length), m_position(other.m_position) {
 
-    Stream &Stream::operator =(const Stream &other) = default;
+        if(m_backingBuffer)
+            m_backingBuffer->acquire(m_offset, m_length);
+    }
+
+    Stream &Stream::operator =(const Stream &other) {
+        if(this != &other) {
+            Stream copy(other);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
 
     Stream::Stream(Stream &&other) noexcept = default;
 
-    Stream &Stream::operator = (Stream &&other) noexcept = default;
+    Stream &Stream::operator = (Stream &&other) noexcept {
+        if(this != &other) {
+            if(m_backingBuffer)
+                m_backingBuffer->release(m_offset, m_length);
+
+            m_byteOrder = other.m_byteOrder;
+            m_operationSet = other.m_operationSet;
+            m_backingBuffer = std::move(other.m_backingBuffer);
+            m_offset = other.m_offset;
+            m_length = other.m_length;
+            m_position = other.m_position;
+        }
+
+        return *this;
+    }
 
     void Stream::setByteOrder(ByteOrder byteOrder) {
         m_byteOrder = byteOrder;
@@ -96,10 +130,11 @@ namespace UnityAsset {
     void Stream::writeData(const unsigned char *data, size_t size) {
         auto endPosition = m_position + size;
         if(endPosition > m_length) {
-            m_length = endPosition;
-
-            if(m_length + m_offset > m_backingBuffer->size())
-                m_backingBuffer->resize(m_offset + m_length);
+            /*
+             * The write always starts within the stream, so the whole
+             * extension is about to be overwritten.
+             */
+            extend(endPosition, true);
         }
 
         memcpy(writableData() + m_position, data, size);
@@ -107,28 +142,102 @@ namespace UnityAsset {
         m_position += size;
     }
 
+    void Stream::readArrayData(void *data, size_t count, size_t elementSize) {
+        if(count > (m_length - m_position) / elementSize) {
+            throw std::logic_error("attempted to read beyond the bounds of the stream");
+        }
+
+        readData(static_cast<unsigned char *>(data), count * elementSize);
+
+        if(m_byteOrder != nativeByteOrder()) {
+            byteSwapArray(data, count, elementSize);
+        }
+    }
+
+    void Stream::writeArrayData(const void *data, size_t count, size_t elementSize) {
+        auto start = m_position;
+
+        writeData(static_cast<const unsigned char *>(data), count * elementSize);
+
+        /*
+         * The swap is done in place, on the data that was just written.
+         */
+        if(m_byteOrder != nativeByteOrder()) {
+            byteSwapArray(writableData() + start, count, elementSize);
+        }
+    }
+
     void Stream::setPosition(size_t position) {
+        if(position > m_length) {
+            extend(position);
+        }
+
         m_position = position;
+    }
+
+    void Stream::adviseAccessPattern(AccessPattern pattern) const {
+        m_backingBuffer->adviseAccessPattern(m_offset, m_length, pattern);
+    }
+
+    void Stream::prefetch(size_t offset, size_t size) const {
+        if(offset > m_length)
+            throw std::logic_error("Stream::prefetch: offset is out of range");
+
+        size = std::min(size, m_length - offset);
+
+        if(size != 0) {
+            m_backingBuffer->prefetch(m_offset + offset, size);
+        }
+    }
 
-        if(m_position > m_length) {
-            m_length = m_position;
+    void Stream::reserve(size_t length) {
+        m_backingBuffer->reserve(m_offset + length);
+    }
 
-            if(m_offset + m_length > m_backingBuffer->size()) {
-                m_backingBuffer->resize(m_offset + m_length);
+    void Stream::extend(size_t length, bool overwrite) {
+        if(m_offset + length > m_backingBuffer->size()) {
+            if(overwrite) {
+                m_backingBuffer->resizeForOverwrite(m_offset + length);
+            } else {
+                m_backingBuffer->resize(m_offset + length);
             }
         }
+
+        /*
+         * The newly covered range is acquired the same way as the range the
+         * stream was created with, so that it's released symmetrically.
+         */
+        m_backingBuffer->acquire(m_offset + m_length, length - m_length);
+
+        m_length = length;
     }
 
     const unsigned char *Stream::data() const {
         return m_backingBuffer->data() + m_offset;
     }
 
-    std::string_view Stream::readNullTerminatedString() {
-        auto begin = reinterpret_cast<const char *>(data() + m_position);
-        auto end = static_cast<const char *>(memchr(begin, 0, m_length - m_position));
+    /*
+     * Finds the end of the string starting at the beginning of the range,
+     * never looking past the range. memchr is used for the scan, as it's
+     * vectorized by every C library that matters.
+     */
+    static const char *findNullTerminator(const char *begin, size_t length) {
+        const char *end = nullptr;
+
+        if(length != 0) {
+            end = static_cast<const char *>(memchr(begin, 0, length));
+        }
+
         if(end == nullptr)
             throw std::runtime_error("the null terminator was not found");
 
+        return end;
+    }
+
+    std::string_view Stream::readNullTerminatedString() {
+        auto begin = reinterpret_cast<const char *>(data() + m_position);
+        auto end = findNullTerminator(begin, m_length - m_position);
+
         m_position += end - begin + 1;
 
         return std::string_view(begin, end);
@@ -4,5 +4,34 @@ namespace UnityAsset {
     StreamBackingBuffer::StreamBackingBuffer() = default;
 
     StreamBackingBuffer::~StreamBackingBuffer() = default;
+
+    void StreamBackingBuffer::resizeForOverwrite(size_t size) {
+        resize(size);
+    }
+
+    void StreamBackingBuffer::reserve(size_t capacity) {
+        (void)capacity;
+    }
+
+    void StreamBackingBuffer::acquire(size_t offset, size_t size) {
+        (void)offset;
+        (void)size;
+    }
+
+    void StreamBackingBuffer::release(size_t offset, size_t size) noexcept {
+        (void)offset;
+        (void)size;
+    }
+
+    void StreamBackingBuffer::adviseAccessPattern(size_t offset, size_t size, AccessPattern pattern) {
+        (void)offset;
+        (void)size;
+        (void)pattern;
+    }
+
+    void StreamBackingBuffer::prefetch(size_t offset, size_t size) {
+        (void)offset;
+        (void)size;
+    }
 }
 
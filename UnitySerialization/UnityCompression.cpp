@@ -42,11 +42,15 @@ namespace UnityAsset {
         if(compression == UnityCompressionType::None && uncompressedLength == input.length())
             return input;
 
-        std::vector<unsigned char> outputData(uncompressedLength);
+        /*
+         * The result outlives the call, so it's not drawn from the scratch
+         * buffer pool, which would round it up to a size class.
+         */
+        std::shared_ptr<StreamBackingBuffer> outputData = std::make_shared<InMemoryStreamBackingBuffer>(uncompressedLength);
 
-        unityUncompress(input.data(), input.length(), compression, outputData.data(), outputData.size());
+        unityUncompress(input.data(), input.length(), compression, outputData->data(), uncompressedLength);
 
-        Stream outputStream(std::make_shared<InMemoryStreamBackingBuffer>(std::move(outputData)));
+        Stream outputStream(outputData);
         return outputStream;
     }
 
@@ -156,7 +160,37 @@ namespace UnityAsset {
         }
     }
 
-    bool unityCompress(const unsigned char *inputData, size_t inputLength, UnityCompressionType compression, unsigned char *outputData, size_t &outputLength) {
+    void validateCompressionLevel(UnityCompressionType compression, int level) {
+        if(level == DefaultCompressionLevel)
+            return;
+
+        bool valid;
+
+        switch(compression) {
+            case UnityCompressionType::LZMA:
+                valid = level >= 0 && level <= 9;
+                break;
+
+            case UnityCompressionType::LZ4:
+                valid = level >= 1;
+                break;
+
+            case UnityCompressionType::LZ4HC:
+                valid = level >= 1 && level <= LZ4HC_CLEVEL_MAX;
+                break;
+
+            default:
+                valid = true;
+                break;
+        }
+
+        if(!valid)
+            throw std::runtime_error("compression level " + std::to_string(level) + " is out of range for the compression type " +
+                                     std::to_string(static_cast<uint32_t>(compression)));
+    }
+
+    bool unityCompress(const unsigned char *inputData, size_t inputLength, UnityCompressionType compression, unsigned char *outputData, size_t &outputLength,
+                       int level) {
         switch(compression) {
             case UnityCompressionType::None:
                 break;
@@ -164,8 +198,11 @@ namespace UnityAsset {
 #ifdef LibLZMA_FOUND
             case UnityCompressionType::LZMA:
             {
+                if(level == DefaultCompressionLevel)
+                    level = 5;
+
                 lzma_options_lzma options;
-                if(lzma_lzma_preset(&options, 5))
+                if(level < 0 || lzma_lzma_preset(&options, static_cast<uint32_t>(level)))
                     throw std::runtime_error("lzma_lzma_preset has failed");
 
                 std::array<lzma_filter, 2> filters{ {
@@ -180,9 +217,8 @@ namespace UnityAsset {
 
                 size_t prefix = proplength;
 
-                if(prefix >= inputLength) {
-                    return false;
-                }
+                if(prefix >= inputLength)
+                    break;
 
                 result = lzma_properties_encode(filters.data(), outputData);
                 if(result != LZMA_OK)
@@ -191,12 +227,10 @@ namespace UnityAsset {
                 outputLength = prefix;
 
                 result = lzma_raw_buffer_encode(filters.data(), nullptr, inputData, inputLength, outputData, &outputLength, inputLength);
-                if(result == LZMA_BUF_ERROR) {
-                    return false;
-                }
+                if(result == LZMA_BUF_ERROR)
+                    break;
 
                 if(result == LZMA_OK) {
-                    printf("LZMA: compressed %zu bytes to %zu bytes\n", inputLength, outputLength);
                     return true;
                 }
 
@@ -206,11 +240,15 @@ namespace UnityAsset {
 
             case UnityCompressionType::LZ4:
             {
-                auto result = LZ4_compress_default(
+                if(level == DefaultCompressionLevel)
+                    level = 1;
+
+                auto result = LZ4_compress_fast(
                     reinterpret_cast<const char *>(inputData),
                     reinterpret_cast<char *>(outputData),
                     inputLength,
-                    inputLength);
+                    inputLength,
+                    level);
                 if(result < 0)
                     throw std::runtime_error("LZ4 compression has failed");
 
@@ -225,12 +263,15 @@ namespace UnityAsset {
 
             case UnityCompressionType::LZ4HC:
             {
+                if(level == DefaultCompressionLevel)
+                    level = LZ4HC_CLEVEL_MAX;
+
                 auto result = LZ4_compress_HC(
                     reinterpret_cast<const char *>(inputData),
                     reinterpret_cast<char *>(outputData),
                     inputLength,
                     inputLength,
-                    LZ4HC_CLEVEL_MAX);
+                    level);
                 if(result < 0)
                     throw std::runtime_error("LZ4 compression has failed");
 
@@ -4,8 +4,19 @@
 
 namespace UnityAsset {
 
-    UnityTypeSerializer::UnityTypeSerializer(Direction direction, Stream &stream, AssetLinker *asset) : m_direction(direction), m_stream(stream),
-        m_linkingAsset(asset) {
+    UnityTypeSerializer::UnityTypeSerializer(StreamView &input, const Stream *source, const FieldSelection *fields) :
+        m_direction(Direction::Read), m_input(&input), m_source(source), m_output(nullptr), m_linkingAsset(nullptr), m_fields(fields),
+        m_depth(0), m_skipping(false) {
+
+    }
+
+    UnityTypeSerializer::UnityTypeSerializer(Stream &output) : m_direction(Direction::Write), m_input(nullptr), m_source(nullptr),
+        m_output(&output), m_linkingAsset(nullptr), m_fields(nullptr), m_depth(0), m_skipping(false) {
+
+    }
+
+    UnityTypeSerializer::UnityTypeSerializer(AssetLinker *asset) : m_direction(Direction::Linking), m_input(nullptr), m_source(nullptr),
+        m_output(nullptr), m_linkingAsset(asset), m_fields(nullptr), m_depth(0), m_skipping(false) {
 
     }
 
@@ -17,15 +28,49 @@ namespace UnityAsset {
 
         if(m_direction == Direction::Read) {
             int32_t length;
-            m_stream >> length;
-            element.resize(length);
-            m_stream.readData(reinterpret_cast<unsigned char *>(element.data()), element.size());
+            *m_input >> length;
+
+            if(m_skipping) {
+                skipArray<uint8_t>(length);
+            } else {
+                element.resize(length);
+                m_input->readData(reinterpret_cast<unsigned char *>(element.data()), element.size());
+            }
         } else {
-            m_stream << static_cast<int32_t>(element.size());
-            m_stream.writeData(reinterpret_cast<const unsigned char *>(element.data()), element.size());
+            *m_output << static_cast<int32_t>(element.size());
+            m_output->writeData(reinterpret_cast<const unsigned char *>(element.data()), element.size());
         }
 
-        m_stream.alignPosition(4);
+        alignPosition(4);
+    }
+
+    void UnityTypeSerializer::serializeValue(TypelessData &element) {
+        if(isLinking())
+            return;
+
+        if(m_direction == Direction::Read) {
+            int32_t length;
+            *m_input >> length;
+
+            if(length < 0 || static_cast<size_t>(length) > m_input->length() - m_input->position())
+                throw std::logic_error("attempted to read beyond the bounds of the stream");
+
+            if(m_skipping) {
+                m_input->skip(length);
+            } else if(m_source) {
+                element = TypelessData(m_source->createView(m_input->position(), length));
+                m_input->skip(length);
+            } else {
+                auto &data = element.mutableData();
+                data.resize(length);
+                m_input->readData(data.data(), data.size());
+            }
+        } else {
+            *m_output << static_cast<int32_t>(element.size());
+            m_output->writeData(element.data(), element.size());
+        }
+
+        alignPosition(4);
     }
 
     Downcastable *UnityTypeSerializer::resolvePointer(int32_t fileID, int64_t pathID) const {
@@ -49,25 +94,30 @@ namespace UnityAsset {
     void UnityTypeSerializer::serializeValue(std::vector<bool> &element) {
         if(m_direction == Direction::Read) {
             int32_t length;
-            m_stream >> length;
-            element.resize(length);
-
-            for(auto item: element) {
-                bool value;
-                serializeValue(value);
-                item = value;
+            *m_input >> length;
+
+            if(m_skipping) {
+                skipArray<uint8_t>(length);
+            } else {
+                element.resize(length);
+
+                for(size_t index = 0; index < element.size(); index++) {
+                    bool value = false;
+                    serializeValue(value);
+                    element[index] = value;
+                }
             }
         } else {
             if(!isLinking())
-                m_stream << static_cast<int32_t>(element.size());
+                *m_output << static_cast<int32_t>(element.size());
 
             for(auto item: element) {
                 bool value = item;
                 serializeValue(value);
             }
         }
-        if(!isLinking())
-            m_stream.alignPosition(4);
+
+        alignPosition(4);
     }
 
 }
@@ -0,0 +1,73 @@
+#ifndef UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_BLOCK_CACHE_H
+#define UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_BLOCK_CACHE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+
+namespace UnityAsset {
+
+    class AssetBundleBlockStreamBackingBuffer;
+
+    /*
+     * Process-wide accounting of the decompressed asset bundle blocks. The
+     * blocks that no Stream refers to anymore are kept resident in the LRU
+     * order, and the least recently used of them are discarded whenever the
+     * total size of the decompressed blocks exceeds the capacity. Blocks
+     * that are still referred to are never discarded, so the capacity can
+     * be exceeded by them.
+     */
+    class AssetBundleBlockCache {
+    public:
+        struct Statistics {
+            uint64_t hits;
+            uint64_t misses;
+            uint64_t evictions;
+            size_t residentBytes;
+            size_t capacity;
+        };
+
+        static AssetBundleBlockCache &instance();
+
+        AssetBundleBlockCache(const AssetBundleBlockCache &other) = delete;
+        AssetBundleBlockCache &operator =(const AssetBundleBlockCache &other) = delete;
+
+        /*
+         * The capacity is in bytes of the decompressed data. The default is
+         * unlimited, which never discards anything.
+         */
+        void setCapacity(size_t capacity);
+        size_t capacity() const;
+
+        Statistics statistics() const;
+        void resetStatistics();
+
+    private:
+        friend class AssetBundleBlockStreamBackingBuffer;
+
+        struct CachedBlock {
+            AssetBundleBlockStreamBackingBuffer *buffer;
+            size_t blockIndex;
+        };
+
+        using UnreferencedBlockList = std::list<CachedBlock>;
+
+        AssetBundleBlockCache();
+        ~AssetBundleBlockCache();
+
+        void evictExcessBlocks();
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_blockStateChanged;
+        UnreferencedBlockList m_unreferencedBlocks;
+        size_t m_capacity;
+        size_t m_residentBytes;
+        uint64_t m_hits;
+        uint64_t m_misses;
+        uint64_t m_evictions;
+    };
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_BLOCK_STREAM_BACKING_BUFFER_H
+#define UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_BLOCK_STREAM_BACKING_BUFFER_H
+
+#include <UnityAsset/Streams/StreamBackingBuffer.h>
+#include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/UnityCompression.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleBlockCache.h>
+
+#include <vector>
+
+namespace UnityAsset {
+
+    struct AssetBundleBlock;
+
+    /*
+     * Holds the uncompressed data area of an asset bundle. The whole
+     * uncompressed size is reserved as address space up front, but the
+     * blocks are only decompressed into it when a Stream covering them
+     * is created. Once no Stream covers a block anymore, it's handed over
+     * to AssetBundleBlockCache, which may discard it.
+     */
+    class AssetBundleBlockStreamBackingBuffer final : public StreamBackingBuffer {
+    public:
+        AssetBundleBlockStreamBackingBuffer(Stream &&compressedData, const std::vector<AssetBundleBlock> &blocks,
+                                            unsigned int decompressionThreads, bool calculateCRC = false);
+        ~AssetBundleBlockStreamBackingBuffer();
+
+        size_t size() const override;
+        void resize(size_t size) override;
+
+        const unsigned char *data() const override;
+
+        void acquire(size_t offset, size_t size) override;
+        void release(size_t offset, size_t size) noexcept override;
+
+        /*
+         * Prefetches the compressed data of the blocks covering the range.
+         */
+        void prefetch(size_t offset, size_t size) override;
+
+        /*
+         * Returns the CRC-32 of the whole uncompressed data. It's combined
+         * from the CRCs of the individual blocks, which are calculated while
+         * each block is decompressed, so it's only available if the buffer
+         * was created with calculateCRC, and the whole buffer is acquired.
+         */
+        uint32_t crc() const;
+
+        /*
+         * The layout of the original compressed blocks, so that they can be
+         * copied through when the bundle is written again.
+         */
+        struct CompressedBlock {
+            size_t uncompressedOffset;
+            size_t uncompressedSize;
+            UnityCompressionType compression;
+            const unsigned char *compressedData;
+            size_t compressedSize;
+        };
+
+        size_t blockCount() const;
+        CompressedBlock compressedBlock(size_t blockIndex) const;
+
+    private:
+        friend class AssetBundleBlockCache;
+
+        enum class BlockState : uint8_t {
+            Absent,
+            Loading,
+            Resident
+        };
+
+        struct Block {
+            size_t compressedOffset;
+            size_t uncompressedOffset;
+            uint32_t compressedSize;
+            uint32_t uncompressedSize;
+            UnityCompressionType compression;
+            BlockState state;
+            bool unreferenced;
+            uint32_t crc;
+            uint32_t references;
+            AssetBundleBlockCache::UnreferencedBlockList::iterator unreferencedPosition;
+        };
+
+        std::vector<Block>::iterator blockContaining(size_t offset);
+        void unreferenceBlocks(std::vector<Block>::iterator firstBlock, size_t endOffset, AssetBundleBlockCache &cache);
+        void uncompressBlocks(const std::vector<Block *> &blocks) const;
+        void prefetchCompressedData(const std::vector<Block *> &blocks) const;
+        size_t discardBlock(size_t blockIndex);
+
+        static size_t queryPageSize();
+
+        Stream m_compressedData;
+        std::vector<Block> m_blocks;
+        unsigned int m_decompressionThreads;
+        bool m_calculateCRC;
+        unsigned char *m_data;
+        size_t m_size;
+
+        static const size_t m_pageSize;
+    };
+}
+
+#endif
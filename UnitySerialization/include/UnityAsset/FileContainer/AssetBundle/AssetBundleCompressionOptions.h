@@ -0,0 +1,42 @@
+#ifndef UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_COMPRESSION_OPTIONS_H
+#define UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_COMPRESSION_OPTIONS_H
+
+#include <UnityAsset/UnityCompression.h>
+
+#include <cstddef>
+
+namespace UnityAsset {
+
+    struct AssetBundleCompressionOptions {
+        /*
+         * Compression level of the data blocks, as interpreted by
+         * unityCompress for AssetBundleFile::dataCompression. Can be
+         * overridden for individual entries.
+         */
+        int level = DefaultCompressionLevel;
+
+        /*
+         * Size of the blocks LZ4 and LZ4HC data is split into.
+         */
+        size_t blockSize = 128 * 1024;
+
+        /*
+         * LZMA data is compressed as a single block unless this is non-zero,
+         * in which case it's split into independently compressed blocks of
+         * this size, which are compressed in parallel.
+         */
+        size_t lzmaBlockSize = 0;
+
+        /*
+         * If set, and the bundle was loaded from a file with compressed data,
+         * serialize(Stream &) splits the data at the same block boundaries
+         * as the original file had, for as far as the data extends, and
+         * copies the blocks whose uncompressed contents didn't change
+         * through without compressing them again. The level isn't applied
+         * to the blocks copied through.
+         */
+        bool reuseUnchangedBlocks = false;
+    };
+}
+
+#endif
@@ -2,15 +2,15 @@
 #define UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_DIRECTORY_H
 
 #include <array>
+#include <optional>
 #include <vector>
 
 #include <UnityAsset/FileContainer/AssetBundle/AssetBundleBlock.h>
 #include <UnityAsset/FileContainer/AssetBundle/AssetBundleDirectoryEntry.h>
+#include <UnityAsset/Streams/Stream.h>
 
 namespace UnityAsset {
 
-    class Stream;
-
     class AssetBundleDirectory {
     public:
         AssetBundleDirectory();
@@ -23,7 +23,8 @@ namespace UnityAsset {
         AssetBundleDirectory &operator =(AssetBundleDirectory &&other) noexcept;
 
         /*
-         * Deserializing constructor.
+         * Deserializing constructor. The paths of the files refer into the
+         * input, so it's retained for the lifetime of the directory.
          */
         explicit AssetBundleDirectory(Stream &&input);
 
@@ -32,6 +33,9 @@ namespace UnityAsset {
         std::array<unsigned char, 16> uncompressedDataHash;
         std::vector<AssetBundleBlock> blocks;
         std::vector<AssetBundleDirectoryEntry> files;
+
+    private:
+        std::optional<Stream> m_input;
     };
 }
 
@@ -2,14 +2,26 @@
 #define UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_ENTRY_H
 
 #include <string>
+#include <memory>
+#include <optional>
 
 #include <UnityAsset/Streams/Stream.h>
 
 namespace UnityAsset {
 
+    class StreamBackingBuffer;
+
     class AssetBundleEntry {
     public:
         AssetBundleEntry(std::string &&filename, Stream &&data, uint32_t flags);
+
+        /*
+         * Creates an entry whose data is only acquired from the backing
+         * buffer when data() is called.
+         */
+        AssetBundleEntry(std::string &&filename, const std::shared_ptr<StreamBackingBuffer> &backingBuffer, size_t offset, size_t size,
+                         uint32_t flags);
+
         ~AssetBundleEntry();
 
         AssetBundleEntry(const AssetBundleEntry &other) = delete;
@@ -22,22 +34,44 @@ namespace UnityAsset {
             return m_filename;
         }
 
-        inline const Stream &data() const {
-            return m_data;
+        /*
+         * The returned Stream keeps the data acquired. For the deferred
+         * entries, the data may be discarded once it and every copy or view
+         * of it are gone, so the pointers obtained from it must not outlive
+         * them. Use size() to get the length without acquiring the data.
+         */
+        Stream data() const;
+
+        inline size_t size() const {
+            return m_size;
         }
 
         inline uint32_t flags() const {
             return m_flags;
         }
 
-        inline void replace(Stream &&data)  {
-            m_data = std::move(data);
+        /*
+         * If set, overrides AssetBundleCompressionOptions::level for the
+         * data of this entry.
+         */
+        inline const std::optional<int> &compressionLevel() const {
+            return m_compressionLevel;
         }
 
+        inline void setCompressionLevel(const std::optional<int> &compressionLevel) {
+            m_compressionLevel = compressionLevel;
+        }
+
+        void replace(Stream &&data);
+
     private:
         std::string m_filename;
-        Stream m_data;
+        std::optional<Stream> m_data;
+        std::shared_ptr<StreamBackingBuffer> m_deferredBackingBuffer;
+        size_t m_deferredOffset;
+        size_t m_size;
         uint32_t m_flags;
+        std::optional<int> m_compressionLevel;
     };
 }
 
@@ -3,16 +3,23 @@
 
 #include <UnityAsset/UnityCompression.h>
 #include <UnityAsset/FileContainer/AssetBundle/AssetBundleEntry.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleLoadOptions.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleCompressionOptions.h>
 
 #include <string_view>
 #include <cstdint>
+#include <limits>
 #include <string>
 #include <vector>
 #include <optional>
+#include <memory>
 
 namespace UnityAsset {
 
     class Stream;
+    class FileDescriptor;
+    class WindowsHandle;
+    class AssetBundleBlockStreamBackingBuffer;
 
     class AssetBundleFile {
     public:
@@ -30,40 +37,74 @@ namespace UnityAsset {
          * Deserializing constructor.
          */
         explicit AssetBundleFile(Stream &&input);
+        AssetBundleFile(Stream &&input, const AssetBundleLoadOptions &options);
 
 
         void serialize(Stream &output) const;
 
+        /*
+         * Serializes the bundle directly into a file, starting at its
+         * beginning, and truncates the file to the size of the bundle. The
+         * data is compressed and written out a window of blocks at a time,
+         * so the memory use doesn't depend on the size of the bundle. The
+         * directory is placed at the end of the file. LZMA data is always
+         * chunked here, into blocks of lzmaBlockSize if it's set, or
+         * blockSize otherwise.
+         */
+#if defined(_WIN32)
+        void serialize(const WindowsHandle &output) const;
+#else
+        void serialize(const FileDescriptor &output) const;
+#endif
+
         std::string unityVersion;
         std::string unityRevision;
 
         UnityCompressionType directoryCompression;
         UnityCompressionType dataCompression;
-        size_t blockSize;
+        AssetBundleCompressionOptions compressionOptions;
+
         std::optional<uint32_t> assetBundleCRC;
 
         std::vector<AssetBundleEntry> entries;
 
     private:
-        static constexpr std::string_view AssetBundleSignature = "UnityFS";
-        static constexpr uint32_t AssetBundleVersion = UINT32_C(6);
+        struct DataChunk {
+            const unsigned char *uncompressedDataStart;
+            size_t uncompressedDataSize;
+            int compressionLevel;
+
+            bool wasCompressed;
 
-        using DirectoryFlags = uint32_t;
+            unsigned char *compressedDataStart;
+            size_t compressedDataSize;
 
-        static inline UnityCompressionType directoryCompressionType(DirectoryFlags flags) {
-            return static_cast<UnityCompressionType>(flags & UINT32_C(0x3f));
-        }
+            size_t originalBlock;
+        };
 
-        static inline uint32_t directoryCompressionOptions(DirectoryFlags flags) {
-            return flags & ~UINT32_C(0x3f);
-        }
+        static constexpr size_t NoOriginalBlock = std::numeric_limits<size_t>::max();
 
+        /*
+         * A range of the data, up to the start of the next one, that's
+         * compressed with the same level.
+         */
+        struct CompressionRun {
+            size_t offset;
+            int level;
+        };
+
+        size_t dataBlockSize() const;
+        static void splitIntoChunks(const unsigned char *data, size_t start, size_t length, unsigned char *compressedData,
+                                    const std::vector<CompressionRun> &runs, size_t chunkSize, std::vector<DataChunk> &chunks);
+        size_t splitIntoOriginalBlocks(const unsigned char *data, size_t length, unsigned char *compressedData,
+                                       const std::vector<CompressionRun> &runs, std::vector<DataChunk> &chunks) const;
+        void compressChunks(std::vector<DataChunk> &chunks) const;
+        bool reuseOriginalBlock(DataChunk &chunk) const;
+
+        static uint32_t calculateCRC32(const unsigned char *data, size_t size, unsigned int threads);
         static uint32_t calculateCRC32Adjustment(uint32_t originalCRC32, uint32_t desiredCRC32);
 
-        static constexpr DirectoryFlags BlocksAndDirectoryInfoCombined = UINT32_C(0x40);
-        static constexpr DirectoryFlags BlocksInfoAtTheEnd = UINT32_C(0x80);
-        static constexpr DirectoryFlags OldWebPluginCompatibility = UINT32_C(0x100);
-        static constexpr DirectoryFlags BlockInfoNeedPaddingAtStart = UINT32_C(0x200);
+        std::shared_ptr<AssetBundleBlockStreamBackingBuffer> m_originalData;
     };
 }
 
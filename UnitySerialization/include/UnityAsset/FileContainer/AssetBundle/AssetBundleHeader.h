@@ -0,0 +1,76 @@
+#ifndef UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_HEADER_H
+#define UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_HEADER_H
+
+#include <UnityAsset/UnityCompression.h>
+#include <UnityAsset/FileContainer/AssetBundle/AssetBundleDirectory.h>
+
+#include <string_view>
+#include <cstdint>
+#include <string>
+
+namespace UnityAsset {
+
+    class Stream;
+
+    /*
+     * The header and the directory of an asset bundle, without any of its
+     * data. Reading it only touches the start of the input and decompresses
+     * nothing but the directory, so it's cheap to do for a large number of
+     * bundles.
+     */
+    class AssetBundleHeader {
+    public:
+        AssetBundleHeader();
+        ~AssetBundleHeader();
+
+        AssetBundleHeader(const AssetBundleHeader &other) = delete;
+        AssetBundleHeader &operator =(const AssetBundleHeader &other) = delete;
+
+        AssetBundleHeader(AssetBundleHeader &&other) noexcept;
+        AssetBundleHeader &operator =(AssetBundleHeader &&other) noexcept;
+
+        /*
+         * Deserializing constructor. The input is not consumed: the data
+         * area of the bundle starts at dataOffset within it.
+         */
+        explicit AssetBundleHeader(const Stream &input);
+
+        std::string unityVersion;
+        std::string unityRevision;
+        uint64_t fileSize;
+
+        UnityCompressionType directoryCompression;
+
+        /*
+         * The compression type of the data blocks, or None if all of them
+         * are stored uncompressed.
+         */
+        UnityCompressionType dataCompression;
+
+        uint64_t dataOffset;
+        size_t totalCompressedSize;
+        size_t totalUncompressedSize;
+
+        AssetBundleDirectory directory;
+
+        static constexpr std::string_view Signature = "UnityFS";
+        static constexpr uint32_t Version = UINT32_C(6);
+
+        using DirectoryFlags = uint32_t;
+
+        static inline UnityCompressionType directoryCompressionType(DirectoryFlags flags) {
+            return static_cast<UnityCompressionType>(flags & UINT32_C(0x3f));
+        }
+
+        static inline uint32_t directoryCompressionOptions(DirectoryFlags flags) {
+            return flags & ~UINT32_C(0x3f);
+        }
+
+        static constexpr DirectoryFlags BlocksAndDirectoryInfoCombined = UINT32_C(0x40);
+        static constexpr DirectoryFlags BlocksInfoAtTheEnd = UINT32_C(0x80);
+        static constexpr DirectoryFlags OldWebPluginCompatibility = UINT32_C(0x100);
+        static constexpr DirectoryFlags BlockInfoNeedPaddingAtStart = UINT32_C(0x200);
+    };
+}
+
+#endif
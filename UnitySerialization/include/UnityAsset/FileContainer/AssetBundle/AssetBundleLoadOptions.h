@@ -0,0 +1,32 @@
+#ifndef UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_LOAD_OPTIONS_H
+#define UNITY_ASSET_FILE_CONTAINER_ASSET_BUNDLE_ASSET_BUNDLE_LOAD_OPTIONS_H
+
+namespace UnityAsset {
+
+    struct AssetBundleLoadOptions {
+        /*
+         * Upper bound on the number of threads the data blocks are
+         * decompressed (and their CRC-32 calculated) on. Zero means
+         * std::thread::hardware_concurrency(), one processes all blocks
+         * serially on the calling thread.
+         */
+        unsigned int decompressionThreads = 0;
+
+        /*
+         * If set, the data blocks are not decompressed during loading, but
+         * only once AssetBundleEntry::data() is requested for an entry that
+         * overlaps them. The CRC-32 of the content is not calculated in this
+         * mode, so assetBundleCRC is left empty.
+         */
+        bool lazyDecompression = false;
+
+        /*
+         * If cleared, the CRC-32 of the content is not calculated and
+         * assetBundleCRC is left empty. It's only needed to reproduce the
+         * same CRC when the bundle is serialized again.
+         */
+        bool calculateCRC = true;
+    };
+}
+
+#endif
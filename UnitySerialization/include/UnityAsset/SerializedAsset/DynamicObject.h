@@ -0,0 +1,74 @@
+#ifndef UNITY_ASSET_SERIALIZED_ASSET_DYNAMIC_OBJECT_H
+#define UNITY_ASSET_SERIALIZED_ASSET_DYNAMIC_OBJECT_H
+
+#include <UnityAsset/SerializedAsset/DynamicType.h>
+#include <UnityAsset/SerializedAsset/DynamicValue.h>
+#include <UnityAsset/Streams/Stream.h>
+
+#include <memory>
+#include <vector>
+
+namespace UnityAsset {
+
+    class SerializedType;
+
+    /*
+     * An object decoded according to its type tree, rather than to a
+     * generated class, such as a MonoBehaviour with the fields of its
+     * script, or an object of a type that is not in the class database.
+     *
+     * Decoding only locates the variable-size nodes; the object keeps the
+     * data it was decoded from, and all values are read from it in place.
+     */
+    class DynamicObject {
+    public:
+        DynamicObject(std::shared_ptr<const DynamicType> type, const Stream &data);
+        DynamicObject(const SerializedType &type, const Stream &data);
+        ~DynamicObject();
+
+        DynamicObject(const DynamicObject &other) = delete;
+        DynamicObject &operator =(const DynamicObject &other) = delete;
+
+        DynamicObject(DynamicObject &&other) noexcept;
+        DynamicObject &operator =(DynamicObject &&other) noexcept;
+
+        inline const DynamicType &type() const {
+            return *m_type;
+        }
+
+        inline const Stream &data() const {
+            return m_data;
+        }
+
+        DynamicValue root() const;
+
+    private:
+        friend class DynamicValue;
+
+        /*
+         * A decoded variable-size node, or a fixed-size field of one. For
+         * the strings, the fixed-size nodes and the arrays of fixed-size
+         * elements, the position is the offset of the data; for the
+         * structures and the other arrays, it's the index of the slot of
+         * the first field or element, with the rest following it.
+         */
+        struct Slot {
+            uint32_t node;
+            uint32_t count;
+            size_t position;
+        };
+
+        void decode();
+        size_t decodeFields(size_t operation, size_t end, size_t slot);
+        int32_t readLength();
+        void checkAvailable(size_t length) const;
+
+        std::shared_ptr<const DynamicType> m_type;
+        Stream m_data;
+        bool m_swapByteOrder;
+        std::vector<Slot> m_slots;
+        size_t m_position;
+    };
+}
+
+#endif
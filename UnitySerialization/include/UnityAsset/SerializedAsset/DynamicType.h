@@ -0,0 +1,156 @@
+#ifndef UNITY_ASSET_SERIALIZED_ASSET_DYNAMIC_TYPE_H
+#define UNITY_ASSET_SERIALIZED_ASSET_DYNAMIC_TYPE_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace UnityAsset {
+
+    class TypeTree;
+    class SerializedType;
+
+    /*
+     * A type tree compiled into a plan for decoding the objects of the type
+     * at run time, without generated code. See DynamicObject.
+     *
+     * The nodes are rearranged so that the children of every node are
+     * adjacent, and the vector, map, set and string nodes are folded
+     * together with the Array node they wrap. The nodes that contain no
+     * arrays, strings or alignment are fixed-size, and are never decoded:
+     * their data is accessed in place. The operations are the nodes
+     * flattened in the serialization order, with the adjacent fixed-size
+     * fields of a structure merged into single operations.
+     */
+    class DynamicType {
+    public:
+        enum class Kind : uint8_t {
+            Bool,
+            Int8,
+            UInt8,
+            Int16,
+            UInt16,
+            Int32,
+            UInt32,
+            Int64,
+            UInt64,
+            Float,
+            Double,
+            String,
+            Array,
+            Struct,
+            /*
+             * Nodes that the type tree doesn't describe the contents of,
+             * such as the managed reference data. Objects with these can
+             * only be decoded if none of them are present.
+             */
+            Unsupported
+        };
+
+        static constexpr uint32_t VariableSize = UINT32_MAX;
+
+        struct Node {
+            std::string_view type;
+            std::string_view name;
+            Kind kind;
+            /*
+             * Whether the stream is aligned to 4 bytes after the node.
+             */
+            bool align;
+            /*
+             * Serialized size of a fixed-size node, VariableSize otherwise.
+             */
+            uint32_t size;
+            /*
+             * For the children of a fixed-size structure, the offset from
+             * the start of the structure. For the fixed-size children of a
+             * variable-size structure, the offset from the start of the
+             * merged operation.
+             */
+            uint32_t offset;
+            /*
+             * The fields of a structure, or the element of an array.
+             */
+            uint32_t firstChild;
+            uint32_t childCount;
+
+            inline bool isFixedSize() const {
+                return size != VariableSize;
+            }
+        };
+
+        enum class OperationCode : uint8_t {
+            /*
+             * 'count' adjacent fixed-size nodes, starting at 'node', that
+             * take up 'extent' bytes.
+             */
+            Fixed,
+            String,
+            /*
+             * An array of fixed-size elements of 'extent' bytes each.
+             */
+            FixedArray,
+            /*
+             * An array of variable-size elements. The operations up to
+             * 'extent' decode one element.
+             */
+            Array,
+            /*
+             * A variable-size structure with 'count' fields, the operations
+             * of which go up to 'extent'.
+             */
+            Struct,
+            Align,
+            Unsupported
+        };
+
+        struct Operation {
+            OperationCode code;
+            uint32_t node;
+            uint32_t count;
+            uint32_t extent;
+        };
+
+        explicit DynamicType(const TypeTree &tree);
+        ~DynamicType();
+
+        DynamicType(const DynamicType &other) = delete;
+        DynamicType &operator =(const DynamicType &other) = delete;
+
+        /*
+         * Returns the compiled type tree of the serialized type, which must
+         * have one. Identical type trees are only compiled once, and share
+         * the result, across all of the files.
+         */
+        static std::shared_ptr<const DynamicType> forType(const SerializedType &type);
+        static std::shared_ptr<const DynamicType> forTypeTree(const TypeTree &tree);
+
+        /*
+         * Drops the compiled types from the cache. The types still in use
+         * are kept alive by their users.
+         */
+        static void clearCache();
+
+        inline const std::vector<Node> &nodes() const {
+            return m_nodes;
+        }
+
+        inline const Node &root() const {
+            return m_nodes.front();
+        }
+
+        inline const std::vector<Operation> &operations() const {
+            return m_operations;
+        }
+
+    private:
+        class Compiler;
+
+        std::vector<char> m_strings;
+        std::vector<Node> m_nodes;
+        std::vector<Operation> m_operations;
+    };
+}
+
+#endif
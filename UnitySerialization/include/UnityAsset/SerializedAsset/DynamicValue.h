@@ -0,0 +1,83 @@
+#ifndef UNITY_ASSET_SERIALIZED_ASSET_DYNAMIC_VALUE_H
+#define UNITY_ASSET_SERIALIZED_ASSET_DYNAMIC_VALUE_H
+
+#include <UnityAsset/SerializedAsset/DynamicType.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace UnityAsset {
+
+    class DynamicObject;
+
+    /*
+     * A node of a DynamicObject. Values are small, and are passed by value;
+     * they refer to the object, which must outlive them.
+     *
+     * The values of the fixed-size nodes are read from the object data
+     * when they're requested, converting the byte order if needed.
+     */
+    class DynamicValue {
+    public:
+        DynamicValue(const DynamicObject *object, uint32_t node, uint32_t slot);
+        DynamicValue(const DynamicObject *object, uint32_t node, const unsigned char *data);
+
+        const DynamicType::Node &node() const;
+
+        inline DynamicType::Kind kind() const {
+            return node().kind;
+        }
+
+        inline std::string_view name() const {
+            return node().name;
+        }
+
+        inline std::string_view typeName() const {
+            return node().type;
+        }
+
+        /*
+         * The number of the fields of a structure, the elements of an array,
+         * or the characters of a string. Zero for everything else.
+         */
+        size_t size() const;
+
+        /*
+         * Accesses an element of an array or a field of a structure.
+         */
+        DynamicValue operator [](size_t index) const;
+        DynamicValue operator [](std::string_view name) const;
+
+        std::optional<DynamicValue> find(std::string_view name) const;
+
+        /*
+         * Converts the value of a primitive node. Any of the numeric kinds
+         * can be converted to any other.
+         */
+        int64_t toInt() const;
+        uint64_t toUInt() const;
+        double toFloat() const;
+        bool toBool() const;
+
+        std::string_view toString() const;
+
+        /*
+         * The serialized data of a fixed-size node, a string, or an array of
+         * fixed-size elements, as is, in the byte order of the object.
+         */
+        const unsigned char *data() const;
+        size_t dataSize() const;
+
+    private:
+        bool isElementFixedSize() const;
+
+        const DynamicObject *m_object;
+        uint32_t m_node;
+        uint32_t m_slot;
+        const unsigned char *m_data;
+    };
+}
+
+#endif
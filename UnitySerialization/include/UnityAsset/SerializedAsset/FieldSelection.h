@@ -0,0 +1,39 @@
+#ifndef UNITY_ASSET_SERIALIZED_ASSET_FIELD_SELECTION_H
+#define UNITY_ASSET_SERIALIZED_ASSET_FIELD_SELECTION_H
+
+#include <initializer_list>
+#include <set>
+#include <string>
+#include <string_view>
+
+namespace UnityAsset {
+
+    /*
+     * The set of the top-level fields of an object to deserialize, by their
+     * names in the generated types. The other fields are skipped over
+     * without being stored, and keep their default values.
+     */
+    class FieldSelection {
+    public:
+        FieldSelection();
+        FieldSelection(std::initializer_list<std::string_view> fields);
+        ~FieldSelection();
+
+        FieldSelection(const FieldSelection &other);
+        FieldSelection &operator =(const FieldSelection &other);
+
+        FieldSelection(FieldSelection &&other) noexcept;
+        FieldSelection &operator =(FieldSelection &&other) noexcept;
+
+        void add(std::string_view field);
+
+        inline bool contains(std::string_view field) const {
+            return m_fields.find(field) != m_fields.end();
+        }
+
+    private:
+        std::set<std::string, std::less<>> m_fields;
+    };
+}
+
+#endif
@@ -13,6 +13,7 @@
 namespace UnityAsset {
 
     class Stream;
+    class SegmentedOutput;
 
     class SerializedAssetFile {
     public:
@@ -33,6 +34,13 @@ namespace UnityAsset {
 
         void serialize(Stream &output) const;
 
+        /*
+         * Serializes without copying the object data: the output references
+         * the object data streams, which then must not be modified until the
+         * output is written.
+         */
+        void serialize(SegmentedOutput &output) const;
+
         uint32_t assetVersion;
         std::string unityVersion;
         int32_t platform = 0;
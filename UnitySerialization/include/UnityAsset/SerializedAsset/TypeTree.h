@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <optional>
+#include <string_view>
 
 #include <UnityAsset/SerializedAsset/TypeTreeNode.h>
 #include <UnityAsset/Streams/Stream.h>
@@ -30,10 +31,23 @@ namespace UnityAsset {
 
         void serialize(Stream &stream) const;
 
+        /*
+         * Resolves the type or name string offset of a node, which refers
+         * either to the string buffer or to the common strings.
+         */
+        std::string_view string(uint32_t offset) const;
+
         std::vector<TypeTreeNode> m_Nodes;
         Stream m_StringBuffer;
         std::optional<ReferenceTypeData> referenceTypeData;
         std::optional<std::vector<int32_t>> m_TypeDependencies;
+
+    private:
+        template<Stream::ByteOrder Order>
+        void readNodes(Stream &stream, int32_t numberOfNodes);
+
+        template<Stream::ByteOrder Order>
+        void writeNodes(Stream &stream) const;
     };
 
 }
@@ -3,13 +3,19 @@
 
 #include <cstdint>
 
+#include <UnityAsset/Streams/Stream.h>
+
 namespace UnityAsset {
 
-    class Stream;
+    template<Stream::ByteOrder Order> class StreamReader;
+    template<Stream::ByteOrder Order> class StreamWriter;
 
     class TypeTreeNode {
     public:
         explicit TypeTreeNode(Stream &stream);
+
+        template<Stream::ByteOrder Order>
+        explicit TypeTreeNode(StreamReader<Order> &reader);
         ~TypeTreeNode();
 
         TypeTreeNode(const TypeTreeNode &other) = delete;
@@ -29,6 +35,9 @@ namespace UnityAsset {
         uint64_t m_RefTypeHash;
 
         void serialize(Stream &stream) const;
+
+        template<Stream::ByteOrder Order>
+        void serialize(StreamWriter<Order> &writer) const;
     };
 }
 
@@ -0,0 +1,74 @@
+#ifndef UNITY_ASSET_SERIALIZED_ASSET_TYPELESS_DATA_H
+#define UNITY_ASSET_SERIALIZED_ASSET_TYPELESS_DATA_H
+
+#include <UnityAsset/Streams/Stream.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace UnityAsset {
+
+    /*
+     * A byte array field of a serialized object. When the object is
+     * deserialized from a Stream, the array refers to the data in place,
+     * instead of being copied out, and is only copied into its own storage
+     * once it's modified through mutableData(). A referenced array keeps
+     * the whole buffer it was loaded from alive.
+     */
+    class TypelessData {
+    public:
+        TypelessData();
+        TypelessData(std::vector<uint8_t> &&data);
+        explicit TypelessData(const Stream &view);
+        ~TypelessData();
+
+        TypelessData(const TypelessData &other);
+        TypelessData &operator =(const TypelessData &other);
+
+        TypelessData(TypelessData &&other) noexcept;
+        TypelessData &operator =(TypelessData &&other) noexcept;
+
+        TypelessData &operator =(std::vector<uint8_t> &&data);
+
+        inline bool isView() const {
+            return m_view.has_value();
+        }
+
+        inline size_t size() const {
+            return m_view ? m_view->length() : m_data.size();
+        }
+
+        inline bool empty() const {
+            return size() == 0;
+        }
+
+        inline const uint8_t *data() const {
+            return m_view ? m_view->data() : m_data.data();
+        }
+
+        inline const uint8_t *begin() const {
+            return data();
+        }
+
+        inline const uint8_t *end() const {
+            return data() + size();
+        }
+
+        inline uint8_t operator [](size_t index) const {
+            return data()[index];
+        }
+
+        /*
+         * Returns the array for modification, copying it out first if it
+         * refers to the data it was loaded from.
+         */
+        std::vector<uint8_t> &mutableData();
+
+    private:
+        std::optional<Stream> m_view;
+        std::vector<uint8_t> m_data;
+    };
+}
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef UNITY_ASSET_SERIALIZED_LAYOUT_H
+#define UNITY_ASSET_SERIALIZED_LAYOUT_H
+
+#include <UnityAsset/Streams/StreamView.h>
+#include <UnityAsset/SerializedAsset/TypelessData.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace UnityAsset {
+
+    constexpr size_t VariableSerializedSize = SIZE_MAX;
+
+    /*
+     * Describes how the values of a type are laid out in the serialized
+     * form, so that they can be skipped over, or their serialized size
+     * computed, without deserializing them.
+     *
+     * FixedSize is the serialized size of the types that always take the
+     * same number of bytes, and VariableSerializedSize for all others. The
+     * fixed-size types are skipped and measured with a constant. Besides
+     * the arithmetic types, and the std::arrays and the pairs of the
+     * fixed-size types, this covers the structures that declare a
+     * FixedSerializedSize, which the generated types do if none of their
+     * fields are aligned after.
+     *
+     * The variable-size generated types provide static skip(StreamView &)
+     * and measure(size_t offset) const themselves. The offset is where the
+     * value starts in the object, which matters for the alignment.
+     */
+    template<typename T>
+    constexpr size_t fixedSerializedSize() {
+        if constexpr(std::is_arithmetic_v<T>) {
+            return sizeof(T);
+        } else if constexpr(requires { T::FixedSerializedSize; }) {
+            return T::FixedSerializedSize;
+        } else {
+            return VariableSerializedSize;
+        }
+    }
+
+    template<typename T>
+    struct SerializedLayout {
+        static constexpr size_t FixedSize = fixedSerializedSize<T>();
+
+        static inline void skip(StreamView &view) {
+            if constexpr(FixedSize != VariableSerializedSize) {
+                view.skip(FixedSize);
+            } else {
+                T::skip(view);
+            }
+        }
+
+        static inline size_t measure(const T &value, size_t position) {
+            if constexpr(FixedSize != VariableSerializedSize) {
+                (void)value;
+                return position + FixedSize;
+            } else {
+                return position + value.measure(position);
+            }
+        }
+    };
+
+    template<typename T>
+    constexpr bool isFixedSerializedSize = SerializedLayout<T>::FixedSize != VariableSerializedSize;
+
+    /*
+     * The total size of the fields, or VariableSerializedSize if any of them
+     * is variable-size.
+     */
+    template<typename... Fields>
+    constexpr size_t sumSerializedSizes() {
+        constexpr size_t sizes[] = { SerializedLayout<Fields>::FixedSize..., 0 };
+
+        size_t total = 0;
+
+        for(auto size: sizes) {
+            if(size == VariableSerializedSize)
+                return VariableSerializedSize;
+
+            total += size;
+        }
+
+        return total;
+    }
+
+    inline size_t alignSerializedPosition(size_t position) {
+        return (position + 3) & ~static_cast<size_t>(3);
+    }
+
+    /*
+     * The arrays, the strings and the byte arrays are all an int32 length,
+     * followed by the elements, and aligned after.
+     */
+    template<typename T>
+    struct SerializedArrayLayout {
+        static constexpr size_t FixedSize = VariableSerializedSize;
+
+        static void skip(StreamView &view) {
+            auto length = view.read<int32_t>();
+            if(length < 0)
+                throw std::runtime_error("negative array length");
+
+            if constexpr(isFixedSerializedSize<T>) {
+                constexpr size_t elementSize = SerializedLayout<T>::FixedSize;
+
+                if constexpr(elementSize != 0) {
+                    if(static_cast<size_t>(length) > (view.length() - view.position()) / elementSize)
+                        throw std::logic_error("attempted to read beyond the bounds of the stream");
+
+                    view.skip(static_cast<size_t>(length) * elementSize);
+                }
+            } else {
+                for(int32_t index = 0; index < length; index++) {
+                    SerializedLayout<T>::skip(view);
+                }
+            }
+
+            view.alignPosition(4);
+        }
+
+        template<typename Container>
+        static size_t measure(const Container &value, size_t position) {
+            position += sizeof(int32_t);
+
+            if constexpr(isFixedSerializedSize<T>) {
+                position += value.size() * SerializedLayout<T>::FixedSize;
+            } else {
+                for(const auto &item: value) {
+                    position = SerializedLayout<T>::measure(item, position);
+                }
+            }
+
+            return alignSerializedPosition(position);
+        }
+    };
+
+    template<typename T>
+    struct SerializedLayout<std::vector<T>> : SerializedArrayLayout<T> {
+
+    };
+
+    template<>
+    struct SerializedLayout<std::string> : SerializedArrayLayout<uint8_t> {
+
+    };
+
+    template<>
+    struct SerializedLayout<TypelessData> : SerializedArrayLayout<uint8_t> {
+
+    };
+
+    template<typename T, size_t Len>
+    struct SerializedLayout<std::array<T, Len>> {
+        static constexpr size_t FixedSize =
+            isFixedSerializedSize<T> ? SerializedLayout<T>::FixedSize * Len : VariableSerializedSize;
+
+        static void skip(StreamView &view) {
+            if constexpr(FixedSize != VariableSerializedSize) {
+                view.skip(FixedSize);
+            } else {
+                for(size_t index = 0; index < Len; index++) {
+                    SerializedLayout<T>::skip(view);
+                }
+            }
+        }
+
+        static size_t measure(const std::array<T, Len> &value, size_t position) {
+            if constexpr(FixedSize != VariableSerializedSize) {
+                (void)value;
+                return position + FixedSize;
+            } else {
+                for(const auto &item: value) {
+                    position = SerializedLayout<T>::measure(item, position);
+                }
+
+                return position;
+            }
+        }
+    };
+
+    template<typename K, typename V>
+    struct SerializedLayout<std::pair<K, V>> {
+        static constexpr size_t FixedSize = sumSerializedSizes<K, V>();
+
+        static void skip(StreamView &view) {
+            if constexpr(FixedSize != VariableSerializedSize) {
+                view.skip(FixedSize);
+            } else {
+                SerializedLayout<K>::skip(view);
+                SerializedLayout<V>::skip(view);
+            }
+        }
+
+        static size_t measure(const std::pair<K, V> &value, size_t position) {
+            position = SerializedLayout<K>::measure(value.first, position);
+            return SerializedLayout<V>::measure(value.second, position);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef UNITY_ASSET_STREAMS_ACCESS_PATTERN_H
+#define UNITY_ASSET_STREAMS_ACCESS_PATTERN_H
+
+namespace UnityAsset {
+
+    /*
+     * How the data of a file-backed buffer is going to be accessed. Passed
+     * through to the kernel as madvise hints, where supported.
+     */
+    enum class AccessPattern {
+        Normal,
+        /*
+         * The data will be read once, from the beginning to the end.
+         */
+        Sequential,
+        /*
+         * The data will be accessed in no particular order, so readahead
+         * is not useful.
+         */
+        Random,
+        /*
+         * All of the data will be needed shortly, and should be read in as
+         * soon as possible.
+         */
+        Preload
+    };
+}
+
+#endif
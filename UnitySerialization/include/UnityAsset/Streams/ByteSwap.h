@@ -0,0 +1,83 @@
+#ifndef UNITY_ASSET_STREAMS_BYTE_SWAP_H
+#define UNITY_ASSET_STREAMS_BYTE_SWAP_H
+
+#include <UnityAsset/Streams/Stream.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+namespace UnityAsset {
+
+    template<typename T>
+    inline T byteSwap(T value) requires std::is_integral_v<T> {
+        if constexpr(sizeof(T) == 1) {
+            return value;
+        } else {
+#if defined(__cpp_lib_byteswap) && __cpp_lib_byteswap >= 202110L
+            return std::byteswap(value);
+#else
+            using Unsigned = std::make_unsigned_t<T>;
+
+            auto bits = static_cast<Unsigned>(value);
+
+#if defined(_MSC_VER)
+            if constexpr(sizeof(T) == 2) {
+                bits = _byteswap_ushort(bits);
+            } else if constexpr(sizeof(T) == 4) {
+                bits = _byteswap_ulong(bits);
+            } else {
+                bits = _byteswap_uint64(bits);
+            }
+#else
+            if constexpr(sizeof(T) == 2) {
+                bits = __builtin_bswap16(bits);
+            } else if constexpr(sizeof(T) == 4) {
+                bits = __builtin_bswap32(bits);
+            } else {
+                bits = __builtin_bswap64(bits);
+            }
+#endif
+
+            return static_cast<T>(bits);
+#endif
+        }
+    }
+
+    template<typename T>
+    inline T byteSwap(T value) requires std::is_floating_point_v<T> {
+        if constexpr(sizeof(T) == 4) {
+            return std::bit_cast<T>(byteSwap(std::bit_cast<uint32_t>(value)));
+        } else {
+            return std::bit_cast<T>(byteSwap(std::bit_cast<uint64_t>(value)));
+        }
+    }
+
+    /*
+     * Reverses the byte order of every element of an array in place. The
+     * element size must be 1, 2, 4 or 8.
+     */
+    void byteSwapArray(void *data, size_t count, size_t elementSize);
+
+    /*
+     * Converts between the native byte order and the given one. The same
+     * operation works in both directions.
+     */
+    template<Stream::ByteOrder Order, typename T>
+    inline T convertByteOrder(T value) {
+        constexpr bool isNative = (Order == Stream::ByteOrder::LeastSignificantFirst) == (std::endian::native == std::endian::little);
+
+        if constexpr(isNative) {
+            return value;
+        } else {
+            return byteSwap(value);
+        }
+    }
+}
+
+#endif
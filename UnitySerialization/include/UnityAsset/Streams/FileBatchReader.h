@@ -0,0 +1,70 @@
+#ifndef UNITY_ASSET_STREAMS_FILE_BATCH_READER_H
+#define UNITY_ASSET_STREAMS_FILE_BATCH_READER_H
+
+#include <UnityAsset/Streams/AccessPattern.h>
+#include <UnityAsset/Streams/Stream.h>
+
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace UnityAsset {
+
+    /*
+     * Reads many whole files at once, and returns them in the order they
+     * complete. The opens, stats and reads for up to maximumInFlight files
+     * are kept in flight, and they continue in the background while the
+     * caller processes the files already returned.
+     *
+     * On Linux, the requests are submitted through io_uring, if the kernel
+     * supports it. Otherwise, the files are read with readFile on a pool of
+     * threads. Either way, the files are read the way readFile does it:
+     * small files are read into memory, and larger ones are mapped.
+     */
+    class FileBatchReader {
+    public:
+        struct Result {
+            /*
+             * Index of the file in the list passed to the constructor.
+             */
+            size_t index;
+
+            /*
+             * Contents of the file, if it was read successfully, or the
+             * error it failed with.
+             */
+            Stream stream;
+            std::exception_ptr error;
+        };
+
+        explicit FileBatchReader(std::vector<std::filesystem::path> paths,
+                                 unsigned int maximumInFlight = 64,
+                                 AccessPattern pattern = AccessPattern::Normal);
+        ~FileBatchReader();
+
+        FileBatchReader(const FileBatchReader &other) = delete;
+        FileBatchReader &operator =(const FileBatchReader &other) = delete;
+
+        FileBatchReader(FileBatchReader &&other) noexcept;
+        FileBatchReader &operator =(FileBatchReader &&other) noexcept;
+
+        /*
+         * Waits for the next file to complete and returns it. Returns
+         * nothing once all of the files were returned.
+         */
+        std::optional<Result> next();
+
+    private:
+        class Backend;
+        class ThreadPoolBackend;
+#if defined(__linux__)
+        class UringBackend;
+#endif
+
+        std::unique_ptr<Backend> m_backend;
+    };
+}
+
+#endif
@@ -1,20 +1,39 @@
 #ifndef UNITY_ASSET_STREAMS_FILE_INPUT_OUTPUT_H
 #define UNITY_ASSET_STREAMS_FILE_INPUT_OUTPUT_H
 
+#include <UnityAsset/Streams/AccessPattern.h>
+
 #include <memory>
 #include <filesystem>
+#include <vector>
 
 namespace UnityAsset {
     class StreamBackingBuffer;
+    class MappedOutputFileStreamBackingBuffer;
     class Stream;
     class FileDescriptor;
     class WindowsHandle;
 
+    /*
+     * Files, or parts of files, smaller than this are read into memory
+     * instead of being mapped.
+     */
+    constexpr size_t FileMappingThreshold = 65536;
+
+    /*
+     * A piece of the data for a gather write.
+     */
+    struct FileSegment {
+        const unsigned char *data;
+        size_t size;
+    };
+
 #if defined(_WIN32)
     std::shared_ptr<StreamBackingBuffer> readFile(
         const WindowsHandle& fd,
         size_t offset = 0,
-        size_t size = std::string::npos
+        size_t size = std::string::npos,
+        AccessPattern pattern = AccessPattern::Normal
     );
 
     void readFile(
@@ -23,11 +42,27 @@ namespace UnityAsset {
         size_t offset,
         size_t size
     );
+
+    void writeFile(
+        const WindowsHandle& fd,
+        const unsigned char* buffer,
+        size_t offset,
+        size_t size
+    );
+
+    void writeFile(
+        const WindowsHandle& fd,
+        const std::vector<FileSegment>& segments,
+        size_t offset
+    );
+
+    void truncateFile(const WindowsHandle& fd, size_t size);
 #else
     std::shared_ptr<StreamBackingBuffer> readFile(
         const FileDescriptor &fd,
         size_t offset = 0,
-        size_t size = std::string::npos
+        size_t size = std::string::npos,
+        AccessPattern pattern = AccessPattern::Normal
     );
 
     void readFile(
@@ -36,15 +71,44 @@ namespace UnityAsset {
         size_t offset,
         size_t size
     );
+
+    void writeFile(
+        const FileDescriptor &fd,
+        const unsigned char *buffer,
+        size_t offset,
+        size_t size
+    );
+
+    /*
+     * Writes the segments back to back, starting at the offset.
+     */
+    void writeFile(
+        const FileDescriptor &fd,
+        const std::vector<FileSegment> &segments,
+        size_t offset
+    );
+
+    /*
+     * Sets the size of the file, discarding anything past it.
+     */
+    void truncateFile(const FileDescriptor &fd, size_t size);
 #endif
 
     std::shared_ptr<StreamBackingBuffer> readFile(
         const std::filesystem::path &path,
         size_t offset = 0,
-        size_t size = std::string::npos
+        size_t size = std::string::npos,
+        AccessPattern pattern = AccessPattern::Normal
     );
 
     void writeFile(const std::filesystem::path &path, const Stream &stream);
+
+    /*
+     * Creates or truncates the file, and returns a buffer mapping it for
+     * writing. A Stream created over the buffer can be passed to the
+     * serialize functions to produce the file without an intermediate copy.
+     */
+    std::shared_ptr<MappedOutputFileStreamBackingBuffer> createOutputFile(const std::filesystem::path &path);
 }
 
 #endif
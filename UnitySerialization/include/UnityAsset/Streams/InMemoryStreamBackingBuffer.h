@@ -3,27 +3,60 @@
 
 #include <UnityAsset/Streams/StreamBackingBuffer.h>
 
+#include <memory>
 #include <vector>
 
 namespace UnityAsset {
 
+    /*
+     * Growable memory buffer. The storage grows geometrically and separately
+     * from the logical size, and the storage past the logical size is left
+     * uninitialized until the buffer is resized over it.
+     */
     class InMemoryStreamBackingBuffer final : public StreamBackingBuffer {
     public:
         InMemoryStreamBackingBuffer();
         explicit InMemoryStreamBackingBuffer(std::vector<unsigned char> &&data);
+
+        /*
+         * Creates a buffer of exactly the specified size with unspecified
+         * contents, which the caller is going to overwrite.
+         */
+        explicit InMemoryStreamBackingBuffer(size_t size);
         ~InMemoryStreamBackingBuffer();
 
         size_t size() const override;
         void resize(size_t size) override;
+        void resizeForOverwrite(size_t size) override;
+        void reserve(size_t capacity) override;
+
+        inline size_t capacity() const {
+            return m_capacity;
+        }
 
         const unsigned char *data() const override;
 
     private:
-        std::vector<unsigned char> m_data;
-
+        void grow(size_t size);
+
+        /*
+         * The smallest storage allocated when the buffer grows on its own,
+         * so that a stream written a few bytes at a time doesn't go through
+         * a run of tiny reallocations first.
+         */
+        static constexpr size_t MinimumGrowthCapacity = 256;
+
+        /*
+         * The data the buffer was created with is used as the storage in
+         * place until the buffer has to grow.
+         */
+        std::vector<unsigned char> m_initialData;
+        std::unique_ptr<unsigned char[]> m_storage;
+        unsigned char *m_data;
+        size_t m_size;
+        size_t m_capacity;
     };
 
 }
 
 #endif
-
@@ -15,9 +15,10 @@ namespace UnityAsset {
     class MappedFileStreamBackingBuffer final : public StreamBackingBuffer {
     public:
 #if defined(_WIN32)
-        MappedFileStreamBackingBuffer(const WindowsHandle &fd, uint64_t offset, size_t size);
+        MappedFileStreamBackingBuffer(const WindowsHandle &fd, uint64_t offset, size_t size,
+                                      AccessPattern pattern = AccessPattern::Normal);
 #else
-        MappedFileStreamBackingBuffer(int fd, off_t offset, size_t size);
+        MappedFileStreamBackingBuffer(int fd, off_t offset, size_t size, AccessPattern pattern = AccessPattern::Normal);
 #endif
 
         ~MappedFileStreamBackingBuffer();
@@ -27,6 +28,9 @@ namespace UnityAsset {
 
         const unsigned char *data() const override;
 
+        void adviseAccessPattern(size_t offset, size_t size, AccessPattern pattern) override;
+        void prefetch(size_t offset, size_t size) override;
+
     private:
 #if defined(_WIN32)
         WindowsHandle m_mapping;
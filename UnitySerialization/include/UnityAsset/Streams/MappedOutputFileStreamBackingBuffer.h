@@ -0,0 +1,70 @@
+#ifndef UNITY_ASSET_STREAMS_MAPPED_OUTPUT_FILE_STREAM_BACKING_BUFFER_H
+#define UNITY_ASSET_STREAMS_MAPPED_OUTPUT_FILE_STREAM_BACKING_BUFFER_H
+
+#include <UnityAsset/Streams/StreamBackingBuffer.h>
+
+#if defined(_WIN32)
+#include <UnityAsset/WindowsHandle.h>
+#else
+#include <UnityAsset/FileDescriptor.h>
+#endif
+
+namespace UnityAsset {
+
+    /*
+     * Writable counterpart of MappedFileStreamBackingBuffer: a growable
+     * buffer that is a shared mapping of an output file, so that a Stream
+     * over it writes directly into the page cache. The file and the mapping
+     * are extended in large steps, and the file is truncated to the size of
+     * the buffer by close().
+     */
+    class MappedOutputFileStreamBackingBuffer final : public StreamBackingBuffer {
+    public:
+#if defined(_WIN32)
+        explicit MappedOutputFileStreamBackingBuffer(WindowsHandle &&file);
+#else
+        explicit MappedOutputFileStreamBackingBuffer(FileDescriptor &&file);
+#endif
+
+        ~MappedOutputFileStreamBackingBuffer();
+
+        size_t size() const override;
+        void resize(size_t size) override;
+        void resizeForOverwrite(size_t size) override;
+        void reserve(size_t capacity) override;
+
+        const unsigned char *data() const override;
+
+        /*
+         * Unmaps the file and truncates it to the size of the buffer. No
+         * streams over the buffer may be used after this call. Called by the
+         * destructor if it wasn't called explicitly, but the errors are only
+         * reported when it's called explicitly.
+         */
+        void close();
+
+    private:
+        void grow(size_t capacity);
+        void unmap() noexcept;
+
+        static constexpr size_t GrowthGranularity = 16 * 1024 * 1024;
+
+#if defined(_WIN32)
+        WindowsHandle m_file;
+        WindowsHandle m_mapping;
+#else
+        FileDescriptor m_file;
+#endif
+        unsigned char *m_data;
+        size_t m_size;
+        size_t m_capacity;
+
+        /*
+         * The storage past this point has never been written, and it's
+         * guaranteed to be zero.
+         */
+        size_t m_clean;
+    };
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef UNITY_ASSET_STREAMS_POOLED_STREAM_BACKING_BUFFER_H
+#define UNITY_ASSET_STREAMS_POOLED_STREAM_BACKING_BUFFER_H
+
+#include <UnityAsset/Streams/StreamBackingBuffer.h>
+#include <UnityAsset/Streams/ScratchBuffer.h>
+
+namespace UnityAsset {
+
+    /*
+     * Growable memory buffer with the storage drawn from ScratchBufferPool.
+     * The storage goes back to the pool when the last Stream over the buffer
+     * is destroyed.
+     */
+    class PooledStreamBackingBuffer final : public StreamBackingBuffer {
+    public:
+        PooledStreamBackingBuffer();
+
+        /*
+         * Creates a buffer of the specified size with unspecified contents,
+         * which the caller is going to overwrite.
+         */
+        explicit PooledStreamBackingBuffer(size_t size);
+
+        ~PooledStreamBackingBuffer();
+
+        size_t size() const override;
+        void resize(size_t size) override;
+        void resizeForOverwrite(size_t size) override;
+        void reserve(size_t capacity) override;
+
+        const unsigned char *data() const override;
+
+    private:
+        void grow(size_t capacity);
+
+        ScratchBuffer m_storage;
+        size_t m_size;
+    };
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef UNITY_ASSET_STREAMS_SCRATCH_BUFFER_H
+#define UNITY_ASSET_STREAMS_SCRATCH_BUFFER_H
+
+#include <cstddef>
+#include <memory>
+
+namespace UnityAsset {
+
+    /*
+     * Uninitialized temporary storage drawn from ScratchBufferPool, and
+     * returned to it when destroyed. The capacity may be larger than the
+     * requested size.
+     */
+    class ScratchBuffer {
+    public:
+        ScratchBuffer() noexcept;
+        explicit ScratchBuffer(size_t size);
+        ~ScratchBuffer();
+
+        ScratchBuffer(const ScratchBuffer &other) = delete;
+        ScratchBuffer &operator =(const ScratchBuffer &other) = delete;
+
+        ScratchBuffer(ScratchBuffer &&other) noexcept;
+        ScratchBuffer &operator =(ScratchBuffer &&other) noexcept;
+
+        inline unsigned char *data() {
+            return m_storage.get();
+        }
+
+        inline const unsigned char *data() const {
+            return m_storage.get();
+        }
+
+        inline size_t capacity() const {
+            return m_capacity;
+        }
+
+        void reset() noexcept;
+
+    private:
+        std::unique_ptr<unsigned char[]> m_storage;
+        size_t m_capacity;
+    };
+}
+
+#endif
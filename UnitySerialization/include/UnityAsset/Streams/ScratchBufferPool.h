@@ -0,0 +1,78 @@
+#ifndef UNITY_ASSET_STREAMS_SCRATCH_BUFFER_POOL_H
+#define UNITY_ASSET_STREAMS_SCRATCH_BUFFER_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace UnityAsset {
+
+    class ScratchBuffer;
+
+    /*
+     * Keeps the storage of the released ScratchBuffers for reuse, so that
+     * the large temporary buffers don't go back to the system and fault
+     * their pages in again on every use. The storage is kept per thread, in
+     * power-of-two size classes, and it's returned to the pool of the thread
+     * that releases it. Each thread retains no more than the configured
+     * number of bytes; the statistics are process-wide.
+     */
+    class ScratchBufferPool {
+    public:
+        struct Statistics {
+            uint64_t hits;
+            uint64_t misses;
+            size_t retainedBytes;
+        };
+
+        /*
+         * The buffers smaller than this aren't pooled, and neither are the
+         * ones larger than the largest size class.
+         */
+        static constexpr size_t MinimumPooledSize = 64 * 1024;
+        static constexpr size_t MaximumPooledSize = size_t(1) << 30;
+
+        static ScratchBufferPool &instance();
+
+        ScratchBufferPool(const ScratchBufferPool &other) = delete;
+        ScratchBufferPool &operator =(const ScratchBufferPool &other) = delete;
+
+        /*
+         * The limit of the bytes retained by each thread. The default is
+         * 256 MiB.
+         */
+        void setRetainedBytesLimit(size_t limit);
+        size_t retainedBytesLimit() const;
+
+        /*
+         * Frees all of the storage retained by the calling thread.
+         */
+        void trim();
+
+        Statistics statistics() const;
+        void resetStatistics();
+
+    private:
+        friend class ScratchBuffer;
+
+        struct ThreadStorage;
+
+        ScratchBufferPool();
+        ~ScratchBufferPool();
+
+        static ThreadStorage *threadStorage();
+
+        static size_t storageCapacity(size_t size);
+
+        std::unique_ptr<unsigned char[]> allocate(size_t capacity);
+        void release(std::unique_ptr<unsigned char[]> &&storage, size_t capacity) noexcept;
+
+        std::atomic<size_t> m_retainedBytesLimit;
+        std::atomic<size_t> m_retainedBytes;
+        std::atomic<uint64_t> m_hits;
+        std::atomic<uint64_t> m_misses;
+    };
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef UNITY_ASSET_STREAMS_SEGMENTED_OUTPUT_H
+#define UNITY_ASSET_STREAMS_SEGMENTED_OUTPUT_H
+
+#include <UnityAsset/Streams/Stream.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace UnityAsset {
+
+    class FileDescriptor;
+    class WindowsHandle;
+
+    /*
+     * Output assembled from references to existing Streams and runs of
+     * zeroes, without copying the data. It's written out with a single
+     * gather write when written to a file.
+     */
+    class SegmentedOutput {
+    public:
+        SegmentedOutput();
+        ~SegmentedOutput();
+
+        SegmentedOutput(const SegmentedOutput &other) = delete;
+        SegmentedOutput &operator =(const SegmentedOutput &other) = delete;
+
+        SegmentedOutput(SegmentedOutput &&other) noexcept;
+        SegmentedOutput &operator =(SegmentedOutput &&other) noexcept;
+
+        /*
+         * Appends the whole of the stream. The stream is referenced, not
+         * copied, so its data must not be modified until the output is
+         * written.
+         */
+        void append(const Stream &data);
+        void appendZeroes(size_t count);
+
+        inline size_t length() const {
+            return m_length;
+        }
+
+        void writeTo(Stream &output) const;
+
+#if defined(_WIN32)
+        void writeTo(const WindowsHandle &output, size_t offset = 0) const;
+#else
+        void writeTo(const FileDescriptor &output, size_t offset = 0) const;
+#endif
+
+    private:
+        struct Segment {
+            std::optional<Stream> data;
+            size_t zeroes;
+        };
+
+        std::vector<Segment> m_segments;
+        size_t m_length;
+    };
+}
+
+#endif
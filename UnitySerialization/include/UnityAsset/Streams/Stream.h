@@ -1,10 +1,13 @@
 #ifndef UNITY_ASSET_STREAMS_STREAM_H
 #define UNITY_ASSET_STREAMS_STREAM_H
 
+#include <UnityAsset/Streams/AccessPattern.h>
+
 #include <memory>
 #include <string_view>
 #include <bit>
 #include <vector>
+#include <type_traits>
 
 namespace UnityAsset {
 
@@ -39,6 +42,20 @@ namespace UnityAsset {
         size_t readSomeData(unsigned char *data, size_t size);
         void writeData(const unsigned char *data, size_t size);
 
+        /*
+         * Read or write an array of primitives in the byte order of the
+         * stream. In the native byte order, these are a single copy.
+         */
+        template<typename T>
+        inline void readArray(T *data, size_t count) requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            readArrayData(data, count, sizeof(T));
+        }
+
+        template<typename T>
+        inline void writeArray(const T *data, size_t count) requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            writeArrayData(data, count, sizeof(T));
+        }
+
         inline size_t position() const {
             return m_position;
         }
@@ -49,6 +66,19 @@ namespace UnityAsset {
             return m_length;
         }
 
+        /*
+         * Preallocates the backing buffer for the stream to grow up to the
+         * specified length without reallocation, if the buffer supports it.
+         */
+        void reserve(size_t length);
+
+        /*
+         * Pass access hints for the stream, or a range of it, to the
+         * backing buffer.
+         */
+        void adviseAccessPattern(AccessPattern pattern) const;
+        void prefetch(size_t offset = 0, size_t size = std::string_view::npos) const;
+
         Stream createView(size_t offset = 0, size_t size = std::string_view::npos) const;
 
         const unsigned char* data() const;
@@ -139,6 +169,11 @@ namespace UnityAsset {
         void alignPosition(size_t alignment);
 
     private:
+        void extend(size_t length, bool overwrite = false);
+
+        void readArrayData(void *data, size_t count, size_t elementSize);
+        void writeArrayData(const void *data, size_t count, size_t elementSize);
+
         inline unsigned char *writableData() {
             return const_cast<unsigned char *>(data());
         }
@@ -295,8 +330,12 @@ namespace UnityAsset {
 
     template<typename T>
     Stream &operator <<(Stream &stream, const std::vector<T> &vector) {
-        for(const auto &entry: vector) {
-            stream << entry;
+        if constexpr(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            stream.writeArray(vector.data(), vector.size());
+        } else {
+            for(const auto &entry: vector) {
+                stream << entry;
+            }
         }
 
         return stream;
@@ -304,8 +343,12 @@ namespace UnityAsset {
 
     template<typename T>
     Stream &operator >>(Stream &stream, std::vector<T> &vector) {
-        for(auto &entry: vector) {
-            stream >> entry;
+        if constexpr(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            stream.readArray(vector.data(), vector.size());
+        } else {
+            for(auto &entry: vector) {
+                stream >> entry;
+            }
         }
 
         return stream;
@@ -1,6 +1,8 @@
 #ifndef UNITY_ASSET_STREAMS_STREAM_BACKING_BUFFER_H
 #define UNITY_ASSET_STREAMS_STREAM_BACKING_BUFFER_H
 
+#include <UnityAsset/Streams/AccessPattern.h>
+
 #include <cstddef>
 
 namespace UnityAsset {
@@ -16,8 +18,40 @@ namespace UnityAsset {
         virtual size_t size() const = 0;
         virtual void resize(size_t size) = 0;
 
+        /*
+         * Same as resize, except that the contents of the newly added range
+         * are unspecified, as the caller is going to overwrite them.
+         */
+        virtual void resizeForOverwrite(size_t size);
+
+        /*
+         * Allows the buffer to preallocate storage for the specified size.
+         */
+        virtual void reserve(size_t capacity);
+
         virtual const unsigned char *data() const = 0;
 
+        /*
+         * Called whenever a Stream over the specified range of the buffer
+         * is created. Buffers that produce their contents on demand must
+         * make the range readable before returning.
+         */
+        virtual void acquire(size_t offset, size_t size);
+
+        /*
+         * Called when a Stream that has acquired the range goes away. After
+         * the last release of a range, the buffer may discard its contents.
+         * Must not throw.
+         */
+        virtual void release(size_t offset, size_t size) noexcept;
+
+        /*
+         * Hints about the upcoming accesses to the range of the buffer. The
+         * buffers that aren't backed by files ignore them.
+         */
+        virtual void adviseAccessPattern(size_t offset, size_t size, AccessPattern pattern);
+        virtual void prefetch(size_t offset, size_t size);
+
         inline unsigned char *data() {
             return const_cast<unsigned char *>(const_cast<const StreamBackingBuffer *>(this)->data());
         }
@@ -0,0 +1,109 @@
+#ifndef UNITY_ASSET_STREAMS_STREAM_READER_H
+#define UNITY_ASSET_STREAMS_STREAM_READER_H
+
+#include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/Streams/ByteSwap.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace UnityAsset {
+
+    /*
+     * A read cursor over a Stream with the byte order fixed at compile time.
+     * Unlike the Stream operators, the primitive reads here are inlined down
+     * to a bounds check, a load and a byte swap, if one is needed. The
+     * position is written back into the stream when the reader is
+     * destroyed, and the stream must not be used while a reader exists.
+     */
+    template<Stream::ByteOrder Order>
+    class StreamReader {
+    public:
+        explicit StreamReader(Stream &stream) : m_stream(stream), m_data(stream.data()), m_length(stream.length()),
+            m_position(stream.position()) {
+
+        }
+
+        ~StreamReader() {
+            m_stream.setPosition(m_position);
+        }
+
+        StreamReader(const StreamReader &other) = delete;
+        StreamReader &operator =(const StreamReader &other) = delete;
+
+        inline size_t position() const {
+            return m_position;
+        }
+
+        inline void setPosition(size_t position) {
+            if(position > m_length)
+                throw std::logic_error("StreamReader::setPosition: position is out of range");
+
+            m_position = position;
+        }
+
+        inline size_t length() const {
+            return m_length;
+        }
+
+        inline void readData(unsigned char *data, size_t size) {
+            if(size > m_length - m_position) {
+                throw std::logic_error("attempted to read beyond the bounds of the stream");
+            }
+
+            memcpy(data, m_data + m_position, size);
+
+            m_position += size;
+        }
+
+        template<typename T>
+        inline T read() requires std::is_arithmetic_v<T> {
+            if constexpr(std::is_same_v<T, bool>) {
+                auto byte = read<uint8_t>();
+                if(byte != 0 && byte != 1)
+                    throw std::runtime_error("bad bool value");
+
+                return byte != 0;
+            } else {
+                T value;
+                readData(reinterpret_cast<unsigned char *>(&value), sizeof(value));
+
+                return convertByteOrder<Order>(value);
+            }
+        }
+
+        template<typename T>
+        inline StreamReader &operator >>(T &value) requires std::is_arithmetic_v<T> {
+            value = read<T>();
+            return *this;
+        }
+
+        inline std::string_view readNullTerminatedString() {
+            auto begin = reinterpret_cast<const char *>(m_data + m_position);
+            const char *end = nullptr;
+            if(m_position != m_length)
+                end = static_cast<const char *>(memchr(begin, 0, m_length - m_position));
+
+            if(end == nullptr)
+                throw std::runtime_error("the null terminator was not found");
+
+            m_position += end - begin + 1;
+
+            return std::string_view(begin, end);
+        }
+
+        inline void alignPosition(size_t alignment) {
+            setPosition((m_position + (alignment - 1)) & ~(alignment - 1));
+        }
+
+    private:
+        Stream &m_stream;
+        const unsigned char *m_data;
+        size_t m_length;
+        size_t m_position;
+    };
+}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef UNITY_ASSET_STREAMS_STREAM_VIEW_H
+#define UNITY_ASSET_STREAMS_STREAM_VIEW_H
+
+#include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/Streams/ByteSwap.h>
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace UnityAsset {
+
+    /*
+     * A non-owning, read-only cursor over stream data, with the byte order
+     * chosen at run time. It's trivially copyable, so, unlike Stream, making
+     * copies and subviews of it touches no reference counts. It's only valid
+     * while the data it was created over is kept alive by a Stream.
+     */
+    class StreamView {
+    public:
+        constexpr StreamView() noexcept : m_data(nullptr), m_length(0), m_position(0),
+            m_byteOrder(Stream::ByteOrder::LeastSignificantFirst) {
+
+        }
+
+        constexpr StreamView(const unsigned char *data, size_t length,
+                             Stream::ByteOrder byteOrder = Stream::ByteOrder::LeastSignificantFirst) noexcept :
+            m_data(data), m_length(length), m_position(0), m_byteOrder(byteOrder) {
+
+        }
+
+        /*
+         * Views the whole stream, starting at its current position.
+         */
+        explicit StreamView(const Stream &stream) noexcept : m_data(stream.data()), m_length(stream.length()),
+            m_position(stream.position()), m_byteOrder(stream.byteOrder()) {
+
+        }
+
+        inline const unsigned char *data() const {
+            return m_data;
+        }
+
+        inline size_t length() const {
+            return m_length;
+        }
+
+        inline size_t position() const {
+            return m_position;
+        }
+
+        inline void setPosition(size_t position) {
+            if(position > m_length)
+                throw std::logic_error("StreamView::setPosition: position is out of range");
+
+            m_position = position;
+        }
+
+        inline Stream::ByteOrder byteOrder() const {
+            return m_byteOrder;
+        }
+
+        inline void setByteOrder(Stream::ByteOrder byteOrder) {
+            m_byteOrder = byteOrder;
+        }
+
+        inline StreamView createView(size_t offset = 0, size_t size = std::string_view::npos) const {
+            if(offset > m_length)
+                throw std::logic_error("StreamView::createView: offset is out of range");
+
+            if(size == std::string_view::npos) {
+                size = m_length - offset;
+            } else if(size > m_length - offset) {
+                throw std::logic_error("StreamView::createView: size is out of range");
+            }
+
+            return StreamView(m_data + offset, size, m_byteOrder);
+        }
+
+        inline void readData(unsigned char *data, size_t size) {
+            if(size > m_length - m_position) {
+                throw std::logic_error("attempted to read beyond the bounds of the stream");
+            }
+
+            if(size != 0) {
+                memcpy(data, m_data + m_position, size);
+            }
+
+            m_position += size;
+        }
+
+        inline void skip(size_t size) {
+            if(size > m_length - m_position) {
+                throw std::logic_error("attempted to read beyond the bounds of the stream");
+            }
+
+            m_position += size;
+        }
+
+        template<typename T>
+        inline T read() requires std::is_arithmetic_v<T> {
+            if constexpr(std::is_same_v<T, bool>) {
+                auto byte = read<uint8_t>();
+                if(byte != 0 && byte != 1)
+                    throw std::runtime_error("bad bool value");
+
+                return byte != 0;
+            } else {
+                T value;
+                readData(reinterpret_cast<unsigned char *>(&value), sizeof(value));
+
+                if(!isNativeByteOrder())
+                    value = byteSwap(value);
+
+                return value;
+            }
+        }
+
+        template<typename T>
+        inline StreamView &operator >>(T &value) requires std::is_arithmetic_v<T> {
+            value = read<T>();
+            return *this;
+        }
+
+        template<typename T>
+        inline void readArray(T *data, size_t count) requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            if(count > (m_length - m_position) / sizeof(T)) {
+                throw std::logic_error("attempted to read beyond the bounds of the stream");
+            }
+
+            readData(reinterpret_cast<unsigned char *>(data), count * sizeof(T));
+
+            if(!isNativeByteOrder())
+                byteSwapArray(data, count, sizeof(T));
+        }
+
+        inline std::string_view readNullTerminatedString() {
+            auto begin = reinterpret_cast<const char *>(m_data + m_position);
+
+            const char *end = nullptr;
+            if(m_position != m_length)
+                end = static_cast<const char *>(memchr(begin, 0, m_length - m_position));
+
+            if(end == nullptr)
+                throw std::runtime_error("the null terminator was not found");
+
+            m_position += end - begin + 1;
+
+            return std::string_view(begin, end);
+        }
+
+        inline void alignPosition(size_t alignment) {
+            setPosition((m_position + (alignment - 1)) & ~(alignment - 1));
+        }
+
+    private:
+        inline bool isNativeByteOrder() const {
+            return (m_byteOrder == Stream::ByteOrder::LeastSignificantFirst) == (std::endian::native == std::endian::little);
+        }
+
+        const unsigned char *m_data;
+        size_t m_length;
+        size_t m_position;
+        Stream::ByteOrder m_byteOrder;
+    };
+
+    static_assert(std::is_trivially_copyable_v<StreamView>);
+}
+
+#endif
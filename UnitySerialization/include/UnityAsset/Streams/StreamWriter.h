@@ -0,0 +1,63 @@
+#ifndef UNITY_ASSET_STREAMS_STREAM_WRITER_H
+#define UNITY_ASSET_STREAMS_STREAM_WRITER_H
+
+#include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/Streams/ByteSwap.h>
+
+#include <string_view>
+#include <type_traits>
+
+namespace UnityAsset {
+
+    /*
+     * Counterpart of StreamReader: writes primitives into a Stream in the
+     * byte order fixed at compile time, without going through the byte
+     * order operation set of the stream.
+     */
+    template<Stream::ByteOrder Order>
+    class StreamWriter {
+    public:
+        explicit StreamWriter(Stream &stream) : m_stream(stream) {
+
+        }
+
+        ~StreamWriter() = default;
+
+        StreamWriter(const StreamWriter &other) = delete;
+        StreamWriter &operator =(const StreamWriter &other) = delete;
+
+        inline void writeData(const unsigned char *data, size_t size) {
+            m_stream.writeData(data, size);
+        }
+
+        template<typename T>
+        inline void write(T value) requires std::is_arithmetic_v<T> {
+            if constexpr(std::is_same_v<T, bool>) {
+                write(static_cast<uint8_t>(value));
+            } else {
+                value = convertByteOrder<Order>(value);
+
+                writeData(reinterpret_cast<const unsigned char *>(&value), sizeof(value));
+            }
+        }
+
+        template<typename T>
+        inline StreamWriter &operator <<(T value) requires std::is_arithmetic_v<T> {
+            write(value);
+            return *this;
+        }
+
+        inline void writeNullTerminatedString(const std::string_view &string) {
+            m_stream.writeNullTerminatedString(string);
+        }
+
+        inline void alignPosition(size_t alignment) {
+            m_stream.alignPosition(alignment);
+        }
+
+    private:
+        Stream &m_stream;
+    };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef UNITY_ASSET_TRIVIAL_SERIALIZATION_H
+#define UNITY_ASSET_TRIVIAL_SERIALIZATION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace UnityAsset {
+
+    /*
+     * Describes the types whose serialized form is the same as their
+     * representation in memory, except possibly for the byte order, and
+     * whose fields all have the same size. Arrays of such types are read
+     * and written with a single copy, and byte swapped, if needed, in units
+     * of FieldSize. FieldSize is zero for all other types.
+     *
+     * Besides the arithmetic types other than bool, and std::arrays of the
+     * qualifying types, this covers the structures that declare
+     * SerializedFieldSize, which the generated types do if none of their
+     * fields are aligned after.
+     */
+    template<typename T>
+    struct TrivialSerialization {
+        static constexpr size_t FieldSize = 0;
+    };
+
+    template<typename T> requires (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8)
+    struct TrivialSerialization<T> {
+        static constexpr size_t FieldSize = sizeof(T);
+    };
+
+    template<typename T, size_t Len>
+    struct TrivialSerialization<std::array<T, Len>> {
+        static constexpr size_t FieldSize = TrivialSerialization<T>::FieldSize;
+    };
+
+    template<typename T> requires requires { T::SerializedFieldSize; }
+    struct TrivialSerialization<T> {
+        static constexpr size_t FieldSize =
+            (std::is_trivially_copyable_v<T> && T::SerializedFieldSize != 0 && sizeof(T) % T::SerializedFieldSize == 0) ?
+            T::SerializedFieldSize : 0;
+    };
+
+    template<typename T>
+    constexpr bool isTriviallySerializable = TrivialSerialization<T>::FieldSize != 0;
+
+    /*
+     * The unsigned integer type of the size of the fields, used to copy and
+     * byte swap the data.
+     */
+    template<typename T> requires isTriviallySerializable<T>
+    using TrivialSerializationField =
+        std::conditional_t<TrivialSerialization<T>::FieldSize == 1, uint8_t,
+        std::conditional_t<TrivialSerialization<T>::FieldSize == 2, uint16_t,
+        std::conditional_t<TrivialSerialization<T>::FieldSize == 4, uint32_t, uint64_t>>>;
+
+    /*
+     * The field size shared by all of the field types, or zero if they don't
+     * all qualify or their sizes differ.
+     */
+    template<typename... Fields>
+    constexpr size_t commonSerializedFieldSize() {
+        constexpr size_t sizes[] = { TrivialSerialization<Fields>::FieldSize... };
+
+        for(auto size: sizes) {
+            if(size != sizes[0])
+                return 0;
+        }
+
+        return sizes[0];
+    }
+}
+
+#endif
@@ -16,9 +16,24 @@ namespace UnityAsset {
         LZHAM = 4
     };
 
+    /*
+     * The meaning of the compression level depends on the compression type:
+     * it's the preset (0-9) for LZMA, the compression level (1-12) for LZ4HC,
+     * and the acceleration factor (1 and up, higher is faster) for LZ4.
+     * DefaultCompressionLevel selects preset 5, LZ4HC_CLEVEL_MAX and
+     * acceleration 1, respectively.
+     */
+    static constexpr int DefaultCompressionLevel = -1;
+
+    /*
+     * Throws if the level is out of the range for the compression type.
+     */
+    void validateCompressionLevel(UnityCompressionType compression, int level);
+
     Stream unityUncompress(Stream &&input, UnityCompressionType compression, size_t uncompressedLength);
     void unityUncompress(const unsigned char *inputData, size_t inputLength, UnityCompressionType compression, unsigned char *outputData, size_t outputLength);
-    bool unityCompress(const unsigned char *inputData, size_t inputLength, UnityCompressionType compression, unsigned char *outputData, size_t &outputLength);
+    bool unityCompress(const unsigned char *inputData, size_t inputLength, UnityCompressionType compression, unsigned char *outputData, size_t &outputLength,
+                       int level = DefaultCompressionLevel);
 }
 
 #endif
@@ -4,11 +4,17 @@
 #include <cstdint>
 
 #include <UnityAsset/Streams/Stream.h>
+#include <UnityAsset/Streams/StreamView.h>
 #include <UnityAsset/SerializedAsset/Downcastable.h>
 #include <UnityAsset/SerializedAsset/ExternalAssetData.h>
+#include <UnityAsset/SerializedAsset/FieldSelection.h>
+#include <UnityAsset/SerializedAsset/TypelessData.h>
+#include <UnityAsset/SerializedLayout.h>
+#include <UnityAsset/TrivialSerialization.h>
 
 #include <type_traits>
 #include <optional>
+#include <string_view>
 
 namespace UnityAsset {
 
@@ -25,46 +31,71 @@ namespace UnityAsset {
             Linking
         };
 
-        UnityTypeSerializer(Direction direction, Stream &stream, AssetLinker *asset = nullptr);
+        explicit UnityTypeSerializer(StreamView &input, const Stream *source = nullptr, const FieldSelection *fields = nullptr);
+        explicit UnityTypeSerializer(Stream &output);
+        explicit UnityTypeSerializer(AssetLinker *asset);
         ~UnityTypeSerializer();
 
     public:
         UnityTypeSerializer(const UnityTypeSerializer &other) = delete;
         UnityTypeSerializer &operator =(const UnityTypeSerializer &other) = delete;
 
+        /*
+         * The name is the name of the field in the generated type, which is
+         * matched against the field selection, if there's one.
+         */
         template<typename T>
-        inline void serialize(T &element, uint32_t flags) {
-            serializeValue(element);
+        inline void serialize(T &element, uint32_t flags, std::string_view name = std::string_view()) {
+            if(m_fields && m_depth == 1 && !m_fields->contains(name)) {
+                m_skipping = true;
+                serializeValue(element);
+                m_skipping = false;
+            } else {
+                serializeValue(element);
+            }
 
             if(flags & 0x4000) {
-                m_stream.alignPosition(4);
+                alignPosition(4);
             }
         }
 
+        /*
+         * The object is read through a StreamView, so that no references
+         * to the backing buffer are taken while it's parsed. The exception
+         * are the TypelessData fields, which refer to the data in place if
+         * the object is deserialized from a Stream, and are copied out
+         * otherwise.
+         */
         template<typename T>
-        static void deserializeObject(const Stream &stream, uint32_t flags, T &result) {
-            Stream input(stream);
-
-            UnityTypeSerializer serializer(Direction::Read, input);
+        static inline void deserializeObject(StreamView input, uint32_t flags, T &result) {
+            deserializeObject(input, nullptr, nullptr, flags, result);
+        }
 
-            serializer.serialize(result, flags);
+        template<typename T>
+        static inline void deserializeObject(const Stream &stream, uint32_t flags, T &result) {
+            deserializeObject(StreamView(stream), &stream, nullptr, flags, result);
+        }
 
-            if(input.position() != stream.length()) {
-                throw std::runtime_error("extra data after the expected end of the object");
-            }
+        /*
+         * Deserializes only the selected top-level fields of the object. The
+         * rest are skipped over: their length prefixes are followed, but
+         * nothing is stored or allocated for them.
+         */
+        template<typename T>
+        static inline void deserializeObject(const Stream &stream, uint32_t flags, T &result, const FieldSelection &fields) {
+            deserializeObject(StreamView(stream), &stream, &fields, flags, result);
         }
 
         template<typename T>
         static void serializeObject(T &object, uint32_t flags, Stream &output) {
-            UnityTypeSerializer serializer(Direction::Write, output);
+            UnityTypeSerializer serializer(output);
 
             serializer.serialize(object, flags);
         }
 
         template<typename T>
         static inline void linkObject(AssetLinker *asset, T &object, uint32_t flags) {
-            Stream stream;
-            UnityTypeSerializer serializer(Direction::Linking, stream, asset);
+            UnityTypeSerializer serializer(asset);
 
             serializer.serialize(object, flags);
         }
@@ -86,6 +117,18 @@ namespace UnityAsset {
         }
 
     private:
+        template<typename T>
+        static void deserializeObject(StreamView input, const Stream *source, const FieldSelection *fields, uint32_t flags,
+                                      T &result) {
+            UnityTypeSerializer serializer(input, source, fields);
+
+            serializer.serialize(result, flags);
+
+            if(input.position() != input.length()) {
+                throw std::runtime_error("extra data after the expected end of the object");
+            }
+        }
+
         Downcastable *resolvePointer(int32_t fileID, int64_t pathID) const;
         std::optional<Stream> resolveExternalAssetData(uint32_t offset, uint32_t size, const std::string &path) const;
 
@@ -93,31 +136,54 @@ namespace UnityAsset {
             return m_direction == Direction::Linking;
         }
 
+        inline void alignPosition(size_t alignment) {
+            if(m_direction == Direction::Read) {
+                m_input->alignPosition(alignment);
+            } else if(m_direction == Direction::Write) {
+                m_output->alignPosition(alignment);
+            }
+        }
+
         template<typename T>
         inline auto serializeValue(T &element) -> typename std::enable_if<std::is_compound<T>::value>::type {
+            m_depth++;
             element.serialize(*this);
+            m_depth--;
         }
 
         template<typename T>
         void serializeValue(std::vector<T> &element) {
             if(m_direction == Direction::Read) {
                 int32_t length;
-                m_stream >> length;
-                element.resize(length);
-
-                for(auto &item: element) {
-                    serializeValue(item);
+                *m_input >> length;
+
+                if(m_skipping) {
+                    skipArray<T>(length);
+                } else {
+                    element.resize(length);
+
+                    if constexpr(isTriviallySerializable<T>) {
+                        readTrivialArray(element.data(), element.size());
+                    } else {
+                        for(auto &item: element) {
+                            serializeValue(item);
+                        }
+                    }
                 }
             } else {
                 if(!isLinking())
-                    m_stream << static_cast<int32_t>(element.size());
-
-                for(auto &item: element) {
-                    serializeValue(item);
+                    *m_output << static_cast<int32_t>(element.size());
+
+                if constexpr(isTriviallySerializable<T>) {
+                    if(m_direction == Direction::Write)
+                        writeTrivialArray(element.data(), element.size());
+                } else {
+                    for(auto &item: element) {
+                        serializeValue(item);
+                    }
                 }
             }
-            if(!isLinking())
-                m_stream.alignPosition(4);
+            alignPosition(4);
         }
 
         void serializeValue(std::vector<bool> &element);
@@ -130,25 +196,97 @@ namespace UnityAsset {
 
         template<typename T, size_t Len>
         void serializeValue(std::array<T, Len> &element) {
-            for(auto &item: element) {
-                serializeValue(item);
+            if constexpr(isTriviallySerializable<T>) {
+                if(m_direction == Direction::Read) {
+                    if(m_skipping) {
+                        m_input->skip(sizeof(element));
+                    } else {
+                        readTrivialArray(element.data(), element.size());
+                    }
+                } else if(m_direction == Direction::Write) {
+                    writeTrivialArray(element.data(), element.size());
+                }
+            } else {
+                for(auto &item: element) {
+                    serializeValue(item);
+                }
             }
         }
 
+        /*
+         * Arrays of trivially serializable elements are copied as a whole,
+         * as an array of their fields.
+         */
+        template<typename T>
+        inline void readTrivialArray(T *data, size_t count) requires isTriviallySerializable<T> {
+            using Field = TrivialSerializationField<T>;
+
+            m_input->readArray(reinterpret_cast<Field *>(data), count * (sizeof(T) / sizeof(Field)));
+        }
+
+        /*
+         * Advances past an array without storing it. Arrays of fixed-size
+         * elements are skipped over at once, and the elements of the
+         * generated types are skipped with their skip functions. Otherwise,
+         * every element is passed through the same scratch value, which
+         * nothing is read into while skipping.
+         */
+        template<typename T>
+        void skipArray(int32_t length) {
+            if(length < 0)
+                throw std::runtime_error("negative array length");
+
+            if constexpr(isFixedSerializedSize<T>) {
+                m_input->skip(static_cast<size_t>(length) * SerializedLayout<T>::FixedSize);
+            } else if constexpr(isTriviallySerializable<T>) {
+                m_input->skip(static_cast<size_t>(length) * sizeof(T));
+            } else if constexpr(requires(StreamView &view) { T::skip(view); }) {
+                for(int32_t index = 0; index < length; index++) {
+                    T::skip(*m_input);
+                }
+            } else {
+                T scratch;
+
+                for(int32_t index = 0; index < length; index++) {
+                    serializeValue(scratch);
+                }
+            }
+        }
+
+        template<typename T>
+        inline void writeTrivialArray(const T *data, size_t count) requires isTriviallySerializable<T> {
+            using Field = TrivialSerializationField<T>;
+
+            m_output->writeArray(reinterpret_cast<const Field *>(data), count * (sizeof(T) / sizeof(Field)));
+        }
+
         void serializeValue(std::string &element);
+        void serializeValue(TypelessData &element);
 
         template<typename T>
         auto serializeValue(T &element) -> typename std::enable_if<!std::is_compound<T>::value>::type {
             if(m_direction == Direction::Read) {
-                m_stream >> element;
+                if(m_skipping) {
+                    m_input->skip(sizeof(element));
+                } else {
+                    *m_input >> element;
+                }
             } else if(m_direction == Direction::Write) {
-                m_stream << element;
+                *m_output << element;
             }
         }
 
         Direction m_direction;
-        Stream &m_stream;
+        StreamView *m_input;
+        /*
+         * The stream the input view was created over, if it's known.
+         */
+        const Stream *m_source;
+        Stream *m_output;
         AssetLinker *m_linkingAsset;
+        const FieldSelection *m_fields;
+        unsigned int m_depth;
+        bool m_skipping;
     };
 
 }
@@ -158,6 +158,10 @@ header.write <<EOF
 
 #include <UnityAsset/SerializedAsset/Downcastable.h>
 #include <UnityAsset/SerializedAsset/ExternalAssetData.h>
+#include <UnityAsset/SerializedAsset/FieldSelection.h>
+#include <UnityAsset/SerializedAsset/TypelessData.h>
+#include <UnityAsset/SerializedLayout.h>
+#include <UnityAsset/TrivialSerialization.h>
 
 EOF
 
@@ -186,7 +190,7 @@ namespace UnityAsset::UnityTypes {
 
   template<typename K, typename V> using UnityMap = std::vector<std::pair<K, V>>;
   template<typename T> using UnitySet = std::vector<T>;
-  using UnityTypelessData = std::vector<uint8_t>;
+  using UnityTypelessData = TypelessData;
 
 EOF
 
@@ -213,6 +217,113 @@ def compose_type_ref(field, reduced)
     ref
 end
 
+NON_TRIVIAL_TYPE_PATTERN = /\b(bool|std::string|std::vector|std::pair|UnityMap|UnitySet|UnityTypelessData|PPtr)\b/
+
+# Emits SerializedFieldSize, which enables copying the arrays of the type in
+# bulk, for the types that have no alignment between their fields. Whether
+# the fields are all of the same size and can be copied is then decided
+# by TrivialSerialization at compile time.
+def write_serialized_field_size(type, reduced, file)
+    return if type.template_argument_count != 0 || type.fields.empty? || type.type_name == "StreamingInfo"
+    return if type.fields.any? { |field| (field.flags & 0x4000) != 0 }
+
+    typerefs = type.fields.map { |field| compose_type_ref field, reduced }
+
+    return if typerefs.any? { |typeref| typeref =~ NON_TRIVIAL_TYPE_PATTERN }
+
+    file.puts "    static constexpr size_t SerializedFieldSize = commonSerializedFieldSize<#{typerefs.join(", ")}>();"
+end
+
+# Types that have no alignment between their fields may be fixed-size, in
+# which case they're skipped and measured with a constant. Whether all of
+# the fields are fixed-size is decided by SerializedLayout at compile time.
+def fixed_size_candidate?(type)
+    type.fields.none? { |field| (field.flags & 0x4000) != 0 }
+end
+
+def write_fixed_serialized_size(type, file)
+    return unless fixed_size_candidate? type
+
+    fields = type.fields.map { |field| "decltype(#{field.field_name})" }
+
+    file.puts "    static constexpr size_t FixedSerializedSize = sumSerializedSizes<#{fields.join(", ")}>();"
+end
+
+def write_skip(type, reduced, source)
+    if type.type_name != "PPtr" || !reduced
+        write_template type, source
+    end
+
+    source.write "    void UnityTypes::#{type.type_name}"
+    if type.type_name != "PPtr" || !reduced
+        source.write template_args type
+    end
+    source.puts "::skip(StreamView &view_) {"
+
+    indent = "      "
+
+    if fixed_size_candidate? type
+        source.puts "      if constexpr(isFixedSerializedSize<#{type.type_name}>) {"
+        source.puts "        view_.skip(FixedSerializedSize);"
+        source.puts "      } else {"
+        indent = "        "
+    end
+
+    type.fields.each do |field|
+        source.puts "#{indent}SerializedLayout<decltype(#{field.field_name})>::skip(view_);"
+
+        if (field.flags & 0x4000) != 0
+            source.puts "#{indent}view_.alignPosition(4);"
+        end
+    end
+
+    if fixed_size_candidate? type
+        source.puts "      }"
+    end
+
+    source.puts "    }"
+end
+
+def write_measure(type, reduced, source)
+    if type.type_name != "PPtr" || !reduced
+        write_template type, source
+    end
+
+    source.write "    size_t UnityTypes::#{type.type_name}"
+    if type.type_name != "PPtr" || !reduced
+        source.write template_args type
+    end
+    source.puts "::measure(size_t startOffset_) const {"
+
+    indent = "      "
+
+    if fixed_size_candidate? type
+        source.puts "      if constexpr(isFixedSerializedSize<#{type.type_name}>) {"
+        source.puts "        (void)startOffset_;"
+        source.puts "        return FixedSerializedSize;"
+        source.puts "      } else {"
+        indent = "        "
+    end
+
+    source.puts "#{indent}auto position_ = startOffset_;"
+
+    type.fields.each do |field|
+        source.puts "#{indent}position_ = SerializedLayout<decltype(this->#{field.field_name})>::measure(this->#{field.field_name}, position_);"
+
+        if (field.flags & 0x4000) != 0
+            source.puts "#{indent}position_ = alignSerializedPosition(position_);"
+        end
+    end
+
+    source.puts "#{indent}return position_ - startOffset_;"
+
+    if fixed_size_candidate? type
+        source.puts "      }"
+    end
+
+    source.puts "    }"
+end
+
 def write_template(type, file)
     if type.template_argument_count != 0
         file.write "  template<"
@@ -267,9 +378,17 @@ database.types.types.each do |type|
         header.puts ";"
     end
 
+    write_serialized_field_size type, reduced, header
+    write_fixed_serialized_size type, header
 
     header.puts "    void serialize(UnityTypeSerializer &serializer);"
 
+    # Advances past a serialized value without deserializing it.
+    header.puts "    static void skip(StreamView &view_);"
+
+    # Serialized size of the value, if it's serialized at the offset.
+    header.puts "    size_t measure(size_t startOffset_ = 0) const;"
+
     if type.type_name != "PPtr" || !reduced
         write_template type, source
     end
@@ -282,7 +401,7 @@ database.types.types.each do |type|
     source.puts "::serialize(UnityTypeSerializer &serializer) {"
 
     type.fields.each do |field|
-        source.puts "      serializer.serialize(#{field.field_name}, #{field.flags});"
+        source.puts "      serializer.serialize(#{field.field_name}, #{field.flags}, \"#{field.field_name}\");"
     end
 
     if type.type_name == "PPtr" && !reduced
@@ -295,6 +414,9 @@ database.types.types.each do |type|
 
     source.puts "    }";
 
+    write_skip type, reduced, source
+    write_measure type, reduced, source
+
     header.puts "};";
 end
 
@@ -389,6 +511,16 @@ EOF
             end
             source.puts "  }"
 
+            header.puts "  void deserialize(const Stream &stream, const FieldSelection &fields);"
+            source.puts "void UnityClasses::#{name}::deserialize(const Stream &stream, const FieldSelection &fields) {"
+            if ref.nil?
+                source.puts "    (void)stream;"
+                source.puts "    (void)fields;"
+            else
+                source.puts "    UnityTypeSerializer::deserializeObject(stream, #{contents.flags}, static_cast<#{ref} &>(*this), fields);"
+            end
+            source.puts "  }"
+
             header.puts "  void serialize(Stream &stream);"
             source.puts "  void UnityClasses::#{name}::serialize(Stream &stream) {"
             if ref.nil?